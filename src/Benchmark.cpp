@@ -0,0 +1,373 @@
+module Chess.Benchmark;
+
+import std;
+
+import Chess.MoveGeneration;
+import Chess.Position;
+import Chess.Position.RepetitionMap;
+import Chess.PositionCommand;
+import Chess.MoveSearch;
+import Chess.SafeInt;
+import Chess.SquareZone;
+
+namespace chess {
+	using namespace std::literals;
+
+	struct LatencySummary {
+		std::chrono::nanoseconds min{ 0 };
+		std::chrono::nanoseconds median{ 0 };
+		std::chrono::nanoseconds max{ 0 };
+	};
+
+	LatencySummary summarize(std::vector<std::chrono::nanoseconds>& samples) {
+		std::ranges::sort(samples);
+		return { samples.front(), samples[samples.size() / 2], samples.back() };
+	}
+
+	void printLatencySummary(std::string_view label, std::vector<std::chrono::nanoseconds>& samples) {
+		auto [min, median, max] = summarize(samples);
+		std::println("{}: min {}, median {}, max {} ({} samples)", label, min, median, max, samples.size());
+	}
+
+	void benchmarkGoLatency() {
+		constexpr auto SEARCH_COUNT = 1000uz;
+
+		AsyncSearch search;
+
+		Position pos;
+		pos.setPos(parsePositionCommand("startpos"));
+		RepetitionMap repetitionMap;
+		repetitionMap.push(pos);
+
+		std::vector<std::chrono::nanoseconds> goToFirstNode;
+		std::vector<std::chrono::nanoseconds> goToBestMove;
+		goToFirstNode.reserve(SEARCH_COUNT);
+		goToBestMove.reserve(SEARCH_COUNT);
+
+		for (auto i = 0uz; i < SEARCH_COUNT; i++) {
+			auto start = std::chrono::steady_clock::now();
+			search.findBestMove(pos, 1_su8, repetitionMap);
+			auto end = std::chrono::steady_clock::now();
+
+			goToFirstNode.push_back(search.getGoLatency());
+			goToBestMove.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start));
+		}
+
+		printLatencySummary("go -> first node", goToFirstNode);
+		printLatencySummary("go -> bestmove (depth 1)", goToBestMove);
+	}
+
+	void benchmarkStopLatency() {
+		constexpr auto SEARCH_COUNT = 50uz;
+		constexpr auto SEARCH_TIME = 50ms;
+
+		AsyncSearch search;
+
+		Position pos;
+		pos.setPos(parsePositionCommand("fen r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R w KQ - 0 8"));
+		RepetitionMap repetitionMap;
+		repetitionMap.push(pos);
+
+		std::vector<std::chrono::nanoseconds> stopToReturn;
+		std::vector<std::chrono::nanoseconds> deadlineToReturn;
+
+		for (auto i = 0uz; i < SEARCH_COUNT; i++) {
+			std::chrono::steady_clock::time_point returned;
+			std::jthread searchThread{ [&] {
+				search.findBestMove(pos, SearchLimits{}, repetitionMap);
+				returned = std::chrono::steady_clock::now();
+			} };
+			std::this_thread::sleep_for(SEARCH_TIME);
+
+			auto stopTime = std::chrono::steady_clock::now();
+			search.cancel();
+			searchThread.join();
+			stopToReturn.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(returned - stopTime));
+		}
+
+		for (auto i = 0uz; i < SEARCH_COUNT; i++) {
+			auto deadline = std::chrono::steady_clock::now() + SEARCH_TIME;
+			search.findBestMove(pos, SearchLimits{ .deadline = deadline }, repetitionMap);
+			auto returned = std::chrono::steady_clock::now();
+			deadlineToReturn.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(returned - deadline));
+		}
+
+		printLatencySummary("stop -> bestmove", stopToReturn);
+		printLatencySummary("deadline -> bestmove", deadlineToReturn);
+	}
+
+	void benchmarkSlidingAttacks() {
+		constexpr auto ITERATION_COUNT = 100000uz;
+		constexpr std::array POSITION_INPUTS{
+			"startpos"sv,
+			"fen r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R w KQ - 0 8"sv,
+			"fen 2r2rk1/1b2qppp/p3pn2/1p6/3NP3/P1B2Q2/1P3PPP/2RR2K1 b - - 4 21"sv,
+			"fen 8/5k2/3q4/8/2B5/4R3/1Q3K2/8 w - - 0 1"sv
+		};
+		std::vector<Position> positions;
+		for (auto input : POSITION_INPUTS) {
+			positions.emplace_back().setPos(parsePositionCommand(input));
+		}
+
+		auto selected = getSlidingAttackBackend();
+		for (auto backend : ALL_SLIDING_ATTACK_BACKENDS) {
+			auto usesPext = backend == SlidingAttackBackend::Pext || backend == SlidingAttackBackend::CompressedPext;
+			if (usesPext && !isBmi2Supported()) {
+				std::println("{:>16}: this cpu has no bmi2", getSlidingAttackBackendName(backend));
+				continue;
+			}
+			setSlidingAttackBackend(backend);
+			auto moveCount = 0uz;
+			auto start = std::chrono::steady_clock::now();
+			for (auto i = 0uz; i < ITERATION_COUNT; i++) {
+				for (const auto& pos : positions) {
+					moveCount += calcPositionData(pos).legalMoves.size();
+				}
+			}
+			auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+			std::println("{:>16}: {} per position ({} moves)", getSlidingAttackBackendName(backend), elapsed / (ITERATION_COUNT * positions.size()), moveCount);
+		}
+		setSlidingAttackBackend(selected);
+	}
+
+	//every position up to two plies away from a few middlegames
+	std::vector<Position> collectMiddlegamePositions() {
+		constexpr std::array POSITION_INPUTS{
+			"fen r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R w KQ - 0 8"sv,
+			"fen 2r2rk1/1b2qppp/p3pn2/1p6/3NP3/P1B2Q2/1P3PPP/2RR2K1 b - - 4 21"sv,
+			"fen r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"sv
+		};
+
+		std::vector<Position> positions;
+		for (auto input : POSITION_INPUTS) {
+			Position root;
+			root.setPos(parsePositionCommand(input));
+			for (const auto& move : calcPositionData(root).legalMoves) {
+				Position child{ root, move };
+				for (const auto& grandchildMove : calcPositionData(child).legalMoves) {
+					positions.emplace_back(child, grandchildMove);
+				}
+			}
+		}
+		return positions;
+	}
+
+	std::vector<SlidingLookup> collectSlidingLookups(std::span<const Position> positions) {
+		std::vector<SlidingLookup> lookups;
+		for (const auto& pos : positions) {
+			auto [white, black] = pos.getColorSides();
+			auto occupied = white.calcAllLocations() | black.calcAllLocations();
+			for (const auto& side : { white, black }) {
+				auto addPieces = [&](Bitboard pieces, bool isRook) {
+					auto square = Square::None;
+					while (nextSquare(pieces, square)) {
+						lookups.emplace_back(square, occupied & ~makeBitboard(square), isRook);
+					}
+				};
+				addPieces(side[Piece::Rook] | side[Piece::Queen], true);
+				addPieces(side[Piece::Bishop] | side[Piece::Queen], false);
+			}
+		}
+		return lookups;
+	}
+
+	void benchmarkSlidingCache() {
+		constexpr std::array CACHE_SIZES{ 32uz << 10, 128uz << 10, 512uz << 10 }; //whatever share of l2 the evaluation and tt leave over
+
+		auto lookups = collectSlidingLookups(collectMiddlegamePositions());
+		std::println("{} lookups", lookups.size());
+		for (auto backend : ALL_SLIDING_ATTACK_BACKENDS) {
+			if (getSlidingTableBytes(backend) == 0) {
+				continue;
+			}
+			std::print("{:>16}: {:>4} KB tables", getSlidingAttackBackendName(backend), getSlidingTableBytes(backend) >> 10);
+			auto touchedBytes = 0uz; //the same for every cache size
+			for (auto cacheSize : CACHE_SIZES) {
+				auto simulation = simulateSlidingTableCache(lookups, backend, cacheSize);
+				touchedBytes = simulation.touchedBytes;
+				std::print(", {} KB cache {:.2f}% hits", cacheSize >> 10, 100.0 * static_cast<double>(simulation.hits) / static_cast<double>(simulation.accesses));
+			}
+			std::println(", {} KB touched", touchedBytes >> 10);
+		}
+	}
+
+	//whole board slider attack maps of both sides, as calcNonPinDestSquares needs them
+	void benchmarkKoggeStone() {
+		constexpr auto ITERATION_COUNT = 200uz;
+
+		struct SliderSet {
+			Bitboard rooksAndQueens = 0;
+			Bitboard bishopsAndQueens = 0;
+			Bitboard empty = 0;
+		};
+		std::vector<SliderSet> sliderSets;
+		for (const auto& pos : collectMiddlegamePositions()) {
+			auto [white, black] = pos.getColorSides();
+			auto empty = ~(white.calcAllLocations() | black.calcAllLocations());
+			for (const auto& side : { white, black }) {
+				sliderSets.emplace_back(side[Piece::Rook] | side[Piece::Queen], side[Piece::Bishop] | side[Piece::Queen], empty);
+			}
+		}
+
+		auto measure = [&](std::string_view name, auto calcAttacks) {
+			auto checksum = 0_bb;
+			auto start = std::chrono::steady_clock::now();
+			for (auto i = 0uz; i < ITERATION_COUNT; i++) {
+				for (const auto& sliders : sliderSets) {
+					checksum ^= calcAttacks(sliders.rooksAndQueens, sliders.bishopsAndQueens, sliders.empty) + i;
+				}
+			}
+			auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+			std::println("{:>16}: {} per side (checksum {:#x})", name, elapsed / (ITERATION_COUNT * sliderSets.size()), checksum);
+		};
+		measure(getSlidingAttackBackendName(getSlidingAttackBackend()), [](Bitboard rooksAndQueens, Bitboard bishopsAndQueens, Bitboard empty) {
+			return calcTableSlidingAttacks(rooksAndQueens, bishopsAndQueens, empty);
+		});
+		if (isAvx2Supported()) {
+			measure("kogge-stone", [](Bitboard rooksAndQueens, Bitboard bishopsAndQueens, Bitboard empty) {
+				return calcKoggeStoneSlidingAttacks(rooksAndQueens, bishopsAndQueens, empty);
+			});
+		} else {
+			std::println("kogge-stone: this cpu has no avx2");
+		}
+	}
+
+	//knight and king attacks by table lookup and by shifting, one piece at a time and a whole side at once
+	void benchmarkLeaperAttacks() {
+		constexpr auto ITERATION_COUNT = 200uz;
+
+		std::vector<Bitboard> knightSets;
+		std::vector<Bitboard> singleKnights;
+		std::vector<Bitboard> kings;
+		for (const auto& pos : collectMiddlegamePositions()) {
+			auto [white, black] = pos.getColorSides();
+			for (const auto& side : { white, black }) {
+				knightSets.push_back(side[Piece::Knight]);
+				kings.push_back(side[Piece::King]);
+				auto knights = side[Piece::Knight];
+				auto square = Square::None;
+				while (nextSquare(knights, square)) {
+					singleKnights.push_back(makeBitboard(square));
+				}
+			}
+		}
+
+		auto measure = [&](std::string_view name, const std::vector<Bitboard>& pieceSets, auto generator) {
+			auto checksum = 0_bb;
+			auto start = std::chrono::steady_clock::now();
+			for (auto i = 0uz; i < ITERATION_COUNT; i++) {
+				for (auto pieces : pieceSets) {
+					checksum ^= generator(pieces, ALL_SQUARES).all() + i;
+				}
+			}
+			auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+			std::println("{:>24}: {} per call (checksum {:#x})", name, elapsed / (ITERATION_COUNT * pieceSets.size()), checksum);
+		};
+		measure("one knight, shifts", singleKnights, knightMoveGenerator);
+		measure("one knight, table", singleKnights, knightTableGenerator);
+		measure("all knights, shifts", knightSets, knightMoveGenerator);
+		measure("all knights, table", knightSets, knightTableGenerator);
+		measure("king, shifts", kings, [](Bitboard king, Bitboard empty) {
+			auto squares = calcSquareZone(king);
+			return MoveGen{ squares & empty, squares & ~empty };
+		});
+		measure("king, table", kings, kingMoveGenerator);
+	}
+
+	//every legal move of positions two plies into a few middlegames, made and taken back
+	void benchmarkMakeMove() {
+		constexpr auto ITERATION_COUNT = 20uz;
+
+		struct PositionMoves {
+			Position pos;
+			std::vector<Move> moves;
+		};
+		std::vector<PositionMoves> positionMoves;
+		auto moveCount = 0uz;
+		for (const auto& pos : collectMiddlegamePositions()) {
+			auto positionData = calcPositionData(pos);
+			const auto& added = positionMoves.emplace_back(pos, std::vector<Move>{ positionData.legalMoves.begin(), positionData.legalMoves.end() });
+			moveCount += added.moves.size();
+		}
+
+		auto measure = [&](std::string_view name, auto makeMove) {
+			auto checksum = 0uz;
+			auto start = std::chrono::steady_clock::now();
+			for (auto i = 0uz; i < ITERATION_COUNT; i++) {
+				for (auto& [pos, moves] : positionMoves) {
+					for (const auto& move : moves) {
+						checksum ^= makeMove(pos, move) + i;
+					}
+				}
+			}
+			auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+			std::println("{:>16}: {} per move (checksum {:#x})", name, elapsed / (ITERATION_COUNT * moveCount), checksum);
+		};
+		std::println("{} moves", moveCount);
+		measure("make + unmake", [](Position& pos, const Move& move) {
+			auto undo = pos.move(move);
+			auto hash = pos.hash();
+			pos.unmake(move, undo);
+			return hash;
+		});
+		measure("copy-make", [](Position& pos, const Move& move) {
+			Position child{ pos, move };
+			return child.hash();
+		});
+	}
+
+	struct Benchmark {
+		std::string_view name;
+		void(*run)();
+	};
+	constexpr std::array BENCHMARKS{
+		Benchmark{ "go_latency", benchmarkGoLatency },
+		Benchmark{ "stop_latency", benchmarkStopLatency },
+		Benchmark{ "sliding_attacks", benchmarkSlidingAttacks },
+		Benchmark{ "sliding_cache", benchmarkSlidingCache },
+		Benchmark{ "kogge_stone", benchmarkKoggeStone },
+		Benchmark{ "make_move", benchmarkMakeMove },
+		Benchmark{ "leaper_attacks", benchmarkLeaperAttacks }
+	};
+
+	void runBenchmark(std::string_view name) {
+		std::println("Sliding attacks: {}{}", getSlidingAttackBackendName(getSlidingAttackBackend()), KOGGE_STONE_SLIDERS_ENABLED ? ", kogge-stone sliders" : "");
+		for (const auto& benchmark : BENCHMARKS) {
+			if (name.empty() || name == benchmark.name) {
+				std::println("Running {}...", benchmark.name);
+				benchmark.run();
+			}
+		}
+	}
+
+	void runSearchStatistics(SafeUnsigned<std::uint8_t> depth, const std::filesystem::path& sessionPath) {
+		constexpr std::array POSITION_INPUTS{
+			"startpos"sv,
+			"fen r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R w KQ - 0 8"sv,
+			"fen r1bqkbnr/pppp1ppp/2n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R b KQkq - 3 3"sv
+		};
+
+		AsyncSearch search;
+		SearchStatistics total;
+		for (auto input : POSITION_INPUTS) {
+			Position pos;
+			pos.setPos(parsePositionCommand(input));
+			RepetitionMap repetitionMap;
+			repetitionMap.push(pos);
+
+			clearTranspositionTable(); //every position starts cold, so runs are comparable
+			search.findBestMove(pos, depth, repetitionMap);
+			total += search.getStatistics();
+		}
+
+		printSearchStatistics(total);
+		writeSearchStatistics(total, sessionPath);
+		std::println("Wrote search statistics to {}", sessionPath.string());
+	}
+
+	void printBenchmarkNames() {
+		for (const auto& benchmark : BENCHMARKS) {
+			std::println("\t{}", benchmark.name);
+		}
+	}
+}
@@ -0,0 +1,12 @@
+export module Chess.Benchmark;
+
+import std;
+import Chess.SafeInt;
+
+export namespace chess {
+	void runBenchmark(std::string_view name);
+	void printBenchmarkNames();
+
+	//searches a fixed set of positions to depth, prints the merged search statistics and adds them to sessionPath
+	void runSearchStatistics(SafeUnsigned<std::uint8_t> depth, const std::filesystem::path& sessionPath);
+}
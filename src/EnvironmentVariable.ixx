@@ -3,5 +3,6 @@ export module Chess.EnvironmentVariable;
 import std;
 
 export namespace chess {
-	std::filesystem::path getAssetDirectoryPath();
+	std::filesystem::path getAssetDirectoryPath(); //exits when CHESS_ASSET_DIR isn't set
+	std::optional<std::filesystem::path> findAssetDirectoryPath(); //for assets that are optional
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+module Chess.GoCommand;
+
+namespace chess {
+	template<typename T>
+	std::optional<T> parseNumber(std::string_view token) {
+		T ret{};
+		auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), ret);
+		if (ec != std::errc{} || ptr != token.data() + token.size()) {
+			return std::nullopt;
+		}
+		return ret;
+	}
+
+	std::optional<std::chrono::milliseconds> parseMilliseconds(std::string_view token) {
+		auto ms = parseNumber<std::int64_t>(token);
+		if (!ms) {
+			return std::nullopt;
+		}
+		return std::chrono::milliseconds{ std::max<std::int64_t>(*ms, 0) }; //some GUIs send negative times once the flag falls
+	}
+
+	GoCommand parseGoCommand(std::string_view goCommandStr) {
+		GoCommand ret;
+
+		//"go" token should already have been consumed in UCI command parser
+		auto tokens = goCommandStr
+			| std::views::split(' ')
+			| std::views::transform([](auto&& rng) { return std::string_view(rng.data(), rng.size()); })
+			| std::views::filter([](std::string_view token) { return !token.empty(); })
+			| std::ranges::to<std::vector>();
+
+		for (size_t i = 0; i < tokens.size(); i++) {
+			auto token = tokens[i];
+			if (token == "infinite") {
+				ret.infinite = true;
+				continue;
+			}
+			if (token == "ponder") {
+				ret.ponder = true;
+				continue;
+			}
+
+			if (i + 1 == tokens.size()) {
+				break;
+			}
+			auto value = tokens[i + 1];
+
+			if (token == "wtime") {
+				ret.whiteTime = parseMilliseconds(value);
+			} else if (token == "btime") {
+				ret.blackTime = parseMilliseconds(value);
+			} else if (token == "winc") {
+				ret.whiteIncrement = parseMilliseconds(value);
+			} else if (token == "binc") {
+				ret.blackIncrement = parseMilliseconds(value);
+			} else if (token == "movetime") {
+				ret.moveTime = parseMilliseconds(value);
+			} else if (token == "movestogo") {
+				ret.movesToGo = parseNumber<int>(value);
+			} else if (token == "depth") {
+				ret.depth = parseNumber<int>(value);
+			} else if (token == "nodes") {
+				ret.nodes = parseNumber<std::uint64_t>(value);
+			} else {
+				continue;
+			}
+			i++;
+		}
+
+		return ret;
+	}
+}
@@ -0,0 +1,20 @@
+export module Chess.GoCommand;
+
+import std;
+
+export namespace chess {
+	struct GoCommand {
+		std::optional<std::chrono::milliseconds> whiteTime;
+		std::optional<std::chrono::milliseconds> blackTime;
+		std::optional<std::chrono::milliseconds> whiteIncrement;
+		std::optional<std::chrono::milliseconds> blackIncrement;
+		std::optional<std::chrono::milliseconds> moveTime;
+		std::optional<int> movesToGo;
+		std::optional<int> depth;
+		std::optional<std::uint64_t> nodes;
+		bool infinite = false;
+		bool ponder = false;
+	};
+
+	GoCommand parseGoCommand(std::string_view goCommandStr);
+}
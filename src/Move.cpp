@@ -7,7 +7,7 @@ module Chess.Move;
 import Chess.Square;
 
 namespace chess {
-	std::string Move::getUCIString() const { //todo: handle pawn promotions 
+	std::string Move::getLongAlgebraicString() const {
 		auto fromName = magic_enum::enum_name(from);
 		auto toName   = magic_enum::enum_name(to);
 
@@ -27,6 +27,10 @@ namespace chess {
 			}
 		}
 
-		return "bestmove " + ret;
+		return ret;
+	}
+
+	std::string Move::getUCIString() const {
+		return "bestmove " + getLongAlgebraicString();
 	}
 }
\ No newline at end of file
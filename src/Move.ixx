@@ -5,6 +5,16 @@ export import Chess.Square;
 export import Chess.PieceType;
 
 namespace chess {
+	//what making the move has to do; Position::move has one path per kind
+	export enum class MoveKind : std::uint8_t {
+		Quiet,
+		Capture,
+		DoublePush,
+		EnPassant,
+		Castle,
+		Promotion //with or without a capture
+	};
+
 	export struct Move {
 		Square from = Square::None;
 		Square to = Square::None;
@@ -12,12 +22,13 @@ namespace chess {
 		Piece movedPiece = Piece::None;
 		Piece capturedPiece = Piece::None;
 		Piece promotionPiece = Piece::None;
+		MoveKind kind = MoveKind::Quiet;
 
 		constexpr Move() = default;
 
 		constexpr Move(Square from, Square to, Square enPessantSquare, Piece movedPiece, Piece capturedPiece, Piece promotedPiece)
 			: from{ from }, to{ to }, capturedPawnSquareEnPassant{ enPessantSquare }, movedPiece { movedPiece }, capturedPiece{ capturedPiece },
-			promotionPiece{ promotedPiece }
+			promotionPiece{ promotedPiece }, kind{ calcKind() }
 		{
 		}
 
@@ -41,10 +52,32 @@ namespace chess {
 				capturedPawnSquareEnPassant == other.capturedPawnSquareEnPassant;
 		}
 
+		//move generators tag the kind as they go; this is for moves built from their squares and pieces alone
+		constexpr MoveKind calcKind() const {
+			if (promotionPiece != Piece::None) {
+				return MoveKind::Promotion;
+			}
+			if (capturedPawnSquareEnPassant != Square::None) {
+				return MoveKind::EnPassant;
+			}
+			if (capturedPiece != Piece::None) {
+				return MoveKind::Capture;
+			}
+			auto distance = std::abs(static_cast<int>(to) - static_cast<int>(from));
+			if (movedPiece == King && distance == 2) {
+				return MoveKind::Castle;
+			}
+			if (movedPiece == Pawn && distance == 16) {
+				return MoveKind::DoublePush;
+			}
+			return MoveKind::Quiet;
+		}
+
 		bool isMaterialChange() const {
 			return capturedPiece != Piece::None || promotionPiece != Piece::None;
 		}
 		
 		std::string getUCIString() const;
+		std::string getLongAlgebraicString() const; //the move alone, as UCI expects it in pv and currmove
 	};
 }
\ No newline at end of file
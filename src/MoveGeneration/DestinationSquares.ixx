@@ -13,9 +13,7 @@ import :Pin;
 
 namespace chess {
 	template<typename MoveGenerator>
-	MoveGen calcDestSquares(Square piecePos, const PinMap& pinMap, const AttackerData& kingAttackerData, 
-		const PieceLocationData& pieceLocations, MoveGenerator moveGen)
-	{
+	MoveGen calcDestSquares(Square piecePos, const PinMasks& pinMasks, const PieceLocationData& pieceLocations, MoveGenerator moveGen) {
 		auto destSquares = [&] {
 			if constexpr (PawnMoveGenerator<MoveGenerator>) {
 				return moveGen(makeBitboard(piecePos), pieceLocations.empty, pieceLocations.enemies);
@@ -24,16 +22,7 @@ namespace chess {
 			}
 		}();
 
-		if (pinMap[piecePos].mustMoveInPinRay) {
-			destSquares.emptyDestSquares &= pinMap[piecePos].pinRay;
-			destSquares.nonEmptyDestSquares &= makeBitboard(pinMap[piecePos].pinnerSquare);
-		}
-
-		auto attackers = kingAttackerData.attackers.calcAllLocations();
-		if (attackers) {
-			destSquares &= (kingAttackerData.rays | attackers);
-		}
-
+		destSquares &= pinMasks.getAllowedSquares(piecePos);
 		return destSquares;
 	}
 
@@ -41,28 +30,26 @@ namespace chess {
 	//concept DestinationSquareInvocable = std::invocable<Square, Piece, const MoveGen&>;
 
 	template<typename MoveGenerator, typename Action>
-	void forEachDestSquareImpl(const PinMap& allyPinMap, const AttackerData& kingAttackerData,
-		Bitboard pieces, Piece pieceType, const PieceLocationData& pieceLocations, MoveGenerator moveGenerator, Action action)
+	void forEachDestSquareImpl(const PinMasks& pinMasks, Bitboard pieces, Piece pieceType, const PieceLocationData& pieceLocations,
+		MoveGenerator moveGenerator, Action action)
 	{
 		auto currSquare = Square::None;
 		while (nextSquare(pieces, currSquare)) {
-			auto destSquares = calcDestSquares(currSquare, allyPinMap, kingAttackerData, pieceLocations, moveGenerator);
+			auto destSquares = calcDestSquares(currSquare, pinMasks, pieceLocations, moveGenerator);
 			action(currSquare, pieceType, destSquares);
 		}
 	}
 
 	template<bool IsWhite, typename Action>
-	void forEachDestSquare(const PieceState& allies, const PinMap& pinMap, const AttackerData& kingAttackerData, 
-		const PieceLocationData& pieceLocations, Action action)
-	{
-		forEachDestSquareImpl(pinMap, kingAttackerData, allies[Queen], Queen, pieceLocations, queenMoveGenerator, action);
-		forEachDestSquareImpl(pinMap, kingAttackerData, allies[Rook], Rook, pieceLocations, rookMoveGenerator, action);
-		forEachDestSquareImpl(pinMap, kingAttackerData, allies[Bishop], Bishop, pieceLocations, bishopMoveGenerator, action);
-		forEachDestSquareImpl(pinMap, kingAttackerData, allies[Knight], Knight, pieceLocations, knightMoveGenerator, action);
+	void forEachDestSquare(const PieceState& allies, const PinMasks& pinMasks, const PieceLocationData& pieceLocations, Action action) {
+		forEachDestSquareImpl(pinMasks, allies[Queen], Queen, pieceLocations, queenMoveGenerator, action);
+		forEachDestSquareImpl(pinMasks, allies[Rook], Rook, pieceLocations, rookMoveGenerator, action);
+		forEachDestSquareImpl(pinMasks, allies[Bishop], Bishop, pieceLocations, bishopMoveGenerator, action);
+		forEachDestSquareImpl(pinMasks, allies[Knight], Knight, pieceLocations, knightTableGenerator, action);
 		if constexpr (IsWhite) {
-			forEachDestSquareImpl(pinMap, kingAttackerData, allies[Pawn], Pawn, pieceLocations, whitePawnMoveGenerator, action);
+			forEachDestSquareImpl(pinMasks, allies[Pawn], Pawn, pieceLocations, whitePawnMoveGenerator, action);
 		} else {
-			forEachDestSquareImpl(pinMap, kingAttackerData, allies[Pawn], Pawn, pieceLocations, blackPawnMoveGenerator, action);
+			forEachDestSquareImpl(pinMasks, allies[Pawn], Pawn, pieceLocations, blackPawnMoveGenerator, action);
 		}
 	}
 
@@ -75,5 +62,5 @@ namespace chess {
 		SquareMap<PieceDestinationSquareData> whiteDestSquareMap;
 		SquareMap<PieceDestinationSquareData> blackDestSquareMap;
 	};
-	export DestinationSquares calcDestinationSquareMap(const Position& pos, const PositionData& posData);
+	export DestinationSquares calcDestinationSquareMap(const Position& pos);
 }
\ No newline at end of file
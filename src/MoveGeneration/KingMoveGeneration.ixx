@@ -1,11 +1,28 @@
 export module Chess.MoveGeneration:KingMoveGeneration;
 
-import Chess.Bitboard;
+import Chess.SquareZone;
 export import Chess.MoveGen;
+export import Chess.Square;
 
 namespace chess {
+	export constexpr auto KING_ATTACKS = [] {
+		SquareMap<Bitboard> ret;
+		for (auto square : SQUARE_ARRAY) {
+			ret[square] = calcSquareZone(makeBitboard(square));
+		}
+		return ret;
+	}();
+
+	//there is only ever one king, so the table always wins over shifting it eight ways
 	struct KingMoveGenerator {
-		MoveGen operator()(Bitboard king, Bitboard empty) const;
+		constexpr MoveGen operator()(Bitboard king, Bitboard empty) const {
+			Bitboard squares = 0;
+			auto currSquare = Square::None;
+			while (nextSquare(king, currSquare)) {
+				squares |= KING_ATTACKS[currSquare];
+			}
+			return { .emptyDestSquares = squares & empty, .nonEmptyDestSquares = squares & ~empty };
+		}
 	};
-	export KingMoveGenerator kingMoveGenerator;
+	export constexpr KingMoveGenerator kingMoveGenerator;
 }
\ No newline at end of file
@@ -1,10 +1,55 @@
 export module Chess.MoveGeneration:KnightMoveGeneration;
 
+import Chess.Direction;
 export import Chess.MoveGen;
+export import Chess.Square;
 
 namespace chess {
+	template<dir::Direction Direction>
+	constexpr Bitboard calcKnightJump(Bitboard movingPieces) {
+		return Direction::move(movingPieces) & Direction::NON_BORDERS;
+	}
+
+	//every square the knights attack, all knights shifted at once
+	export constexpr Bitboard calcSetwiseKnightAttacks(Bitboard movingPieces) {
+		return calcKnightJump<dir::knight::NorthEastEast>(movingPieces) |
+			calcKnightJump<dir::knight::NorthNorthEast>(movingPieces)   |
+			calcKnightJump<dir::knight::NorthNorthWest>(movingPieces)   |
+			calcKnightJump<dir::knight::NorthWestWest>(movingPieces)    |
+			calcKnightJump<dir::knight::SouthEastEast>(movingPieces)    |
+			calcKnightJump<dir::knight::SouthSouthEast>(movingPieces)   |
+			calcKnightJump<dir::knight::SouthSouthWest>(movingPieces)   |
+			calcKnightJump<dir::knight::SouthWestWest>(movingPieces);
+	}
+
+	export constexpr auto KNIGHT_ATTACKS = [] {
+		SquareMap<Bitboard> ret;
+		for (auto square : SQUARE_ARRAY) {
+			ret[square] = calcSetwiseKnightAttacks(makeBitboard(square));
+		}
+		return ret;
+	}();
+
+	//for a whole side's knights; how many there are varies, so a loop over the table would mispredict
 	struct KnightMoveGenerator {
-		MoveGen operator()(Bitboard movingPieces, Bitboard empty) const;
+		constexpr MoveGen operator()(Bitboard movingPieces, Bitboard empty) const {
+			auto attacks = calcSetwiseKnightAttacks(movingPieces);
+			return { attacks & empty, attacks & ~empty };
+		}
 	};
+
+	//for a single knight, or the knights attacking a single square; one load instead of eight shifts
+	struct KnightTableGenerator {
+		constexpr MoveGen operator()(Bitboard movingPieces, Bitboard empty) const {
+			Bitboard attacks = 0;
+			auto currSquare = Square::None;
+			while (nextSquare(movingPieces, currSquare)) {
+				attacks |= KNIGHT_ATTACKS[currSquare];
+			}
+			return { attacks & empty, attacks & ~empty };
+		}
+	};
+
 	export constexpr KnightMoveGenerator knightMoveGenerator;
+	export constexpr KnightTableGenerator knightTableGenerator;
 }
\ No newline at end of file
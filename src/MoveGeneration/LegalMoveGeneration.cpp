@@ -10,6 +10,7 @@ import std;
 
 import Chess.Assert;
 import Chess.BitboardImage;
+import Chess.Direction;
 import Chess.PieceMap;
 import Chess.RankCalculator;
 
@@ -43,15 +44,29 @@ namespace chess {
 		static constexpr auto PAWN_ADDER = [](MoveVector& moves, Move move) {
 			if (makeBitboard(move.to) & PromotionRank) {
 				constexpr std::array PROMOTION_PIECES{ Queen, Rook, Bishop, Knight };
+				move.kind = MoveKind::Promotion;
 				for (auto piece : PROMOTION_PIECES) {
 					move.promotionPiece = piece;
 					moves.push_back(move);
 				}
 			} else {
+				if (move.kind != MoveKind::Capture) {
+					auto isDoublePush = std::abs(static_cast<int>(move.to) - static_cast<int>(move.from)) == 16;
+					move.kind = isDoublePush ? MoveKind::DoublePush : MoveKind::Quiet;
+				}
 				moves.push_back(move);
 			}
 		};
 
+		//castling is a king move of two squares, found among the king's quiet moves
+		static constexpr auto KING_ADDER = [](MoveVector& moves, Move move) {
+			if (move.kind != MoveKind::Capture) {
+				auto isCastle = std::abs(static_cast<int>(move.to) - static_cast<int>(move.from)) == 2;
+				move.kind = isCastle ? MoveKind::Castle : MoveKind::Quiet;
+			}
+			moves.push_back(move);
+		};
+
 		static constexpr auto DEFAULT_MOVE_ADDER = [](MoveVector& moves, const Move& move) {
 			moves.push_back(move);
 		};
@@ -61,13 +76,13 @@ namespace chess {
 			const PieceLocationData& pieceLocations, const PieceState& enemies, MoveAdder moveAdder)
 		{
 			posData.getAllySquares().destSquaresPinConsidered |= destSquares.all();
-			posData.getAllySquares().allDestSquares        |= destSquares.all();
 
 			Move move{ piecePos, Square::None, pieceType, Piece::None };
 
 			while (nextSquare(destSquares.emptyDestSquares, move.to)) {
 				moveAdder(posData.legalMoves, move);
 			}
+			move.kind = MoveKind::Capture;
 			auto capturedPieceSquares = destSquares.nonEmptyDestSquares & pieceLocations.enemies;
 			while (nextSquare(capturedPieceSquares, move.to)) {
 				move.capturedPiece = enemies.findPiece(move.to);
@@ -112,27 +127,31 @@ namespace chess {
 			return ret;
 		}
 
+		//every square the pieces attack, pins aside; enough to tell where the other king can't go
 		template<PawnMoveGenerator PawnGenerator>
 		static Bitboard calcNonPinDestSquares(const PieceState& pieces, const PieceLocationData& pieceLocations, PawnGenerator pawnMoveGenerator) {
 			Bitboard ret = 0;
-			ret |= queenMoveGenerator(pieces[Queen], pieceLocations.empty).all();
-			ret |= bishopMoveGenerator(pieces[Bishop], pieceLocations.empty).all();
-			ret |= rookMoveGenerator(pieces[Rook], pieceLocations.empty).all();
+			ret |= kingMoveGenerator(pieces[King], pieceLocations.empty).all();
+			ret |= calcSlidingAttacks(pieces[Rook] | pieces[Queen], pieces[Bishop] | pieces[Queen], pieceLocations.empty);
 			ret |= knightMoveGenerator(pieces[Knight], pieceLocations.empty).all();
 			ret |= pawnMoveGenerator(pieces[Pawn], pieceLocations.empty, ALL_SQUARES).all(); //ensure pawns actually defend fellow enemy pieces
 			return ret;
 		}
 
-		static void addEnPassantMoves(PositionData& posData, const PinMap& pinMap, const AttackerData& kingAttackers, 
+		static void addEnPassantMoves(PositionData& posData, const PinMasks& pinMasks, const AttackerData& kingAttackers, 
 			const PieceState& enemies, Bitboard pawns, Square jumpedEnemyPawn, const PieceLocationData& pieceLocations)
 		{
 			auto enPassantData = allyPawnAttackGenerator(pawns, jumpedEnemyPawn);
 			if (!enPassantData.pawns) {
 				return;
 			}
+			auto capturedOrBlocked = makeBitboard(jumpedEnemyPawn, enPassantData.squareInFrontOfEnemyPawn);
+			if (!(capturedOrBlocked & pinMasks.checkMask)) { //doesn't take the checker or block its ray
+				return;
+			}
 			auto from = Square::None;
 			while (nextSquare(enPassantData.pawns, from)) {
-				if (pinMap[from].mustMoveInPinRay) { //impossible for an en passant pawn to be pinned by a pawn, so it can't take the double jumped pawn
+				if (pinMasks.isPinned(from)) { //impossible for an en passant pawn to be pinned by a pawn, so it can't take the double jumped pawn
 					continue;
 				}
 				PieceLocationData newPieceLocations{
@@ -145,90 +164,162 @@ namespace chess {
 					continue;
 				}
 				posData.legalMoves.emplace_back(from, enPassantData.squareInFrontOfEnemyPawn, jumpedEnemyPawn, Pawn, Pawn, Piece::None);
-				MoveGen gen{ 0, makeBitboard(enPassantData.squareInFrontOfEnemyPawn) };
+				posData.getAllySquares().destSquaresPinConsidered |= makeBitboard(enPassantData.squareInFrontOfEnemyPawn);
+			}
+		}
+
+		//with a single checker, only captures of it and blocks on its ray help, so the moves are found backwards from those squares
+		static void addCheckEvasions(PositionData& posData, const PieceState& allies, const PieceState& enemies, const PinMasks& pinMasks,
+			const PieceLocationData& pieceLocations)
+		{
+			using Backward = std::conditional_t<White, dir::sliding::South, dir::sliding::North>;
+			constexpr auto JUMP_RANK = White ? calcRank<2>() : calcRank<7>();
+
+			auto movablePieces = pieceLocations.allies & ~pinMasks.pinned; //a pinned piece can never reach the ray of another checker
+			auto targets = pinMasks.checkMask;
+			auto target = Square::None;
+			while (nextSquare(targets, target)) {
+				auto targetBoard = makeBitboard(target);
+				auto capturedPiece = (targetBoard & pieceLocations.enemies) ? enemies.findPiece(target) : Piece::None;
+
+				auto reached = false;
+				auto addMovesFrom = [&](Bitboard pieces, Piece pieceType) {
+					pieces &= movablePieces;
+					reached |= pieces != 0;
+					Move move{ Square::None, target, pieceType, capturedPiece };
+					while (nextSquare(pieces, move.from)) {
+						if (pieceType == Pawn) {
+							PAWN_ADDER(posData.legalMoves, move);
+						} else {
+							DEFAULT_MOVE_ADDER(posData.legalMoves, move);
+						}
+					}
+				};
+
+				auto diagonalPieces = bishopMoveGenerator(targetBoard, pieceLocations.empty).nonEmptyDestSquares;
+				auto orthogonalPieces = rookMoveGenerator(targetBoard, pieceLocations.empty).nonEmptyDestSquares;
+				addMovesFrom((diagonalPieces | orthogonalPieces) & allies[Queen], Queen);
+				addMovesFrom(orthogonalPieces & allies[Rook], Rook);
+				addMovesFrom(diagonalPieces & allies[Bishop], Bishop);
+				addMovesFrom(knightTableGenerator(targetBoard, ~allies[Knight]).nonEmptyDestSquares, Knight);
+				if (capturedPiece != Piece::None) {
+					addMovesFrom(enemyPawnAttackGenerator(targetBoard, allies[Pawn]).nonEmptyDestSquares, Pawn); //the enemy's attacks from the target land on the pawns that attack it
+				} else {
+					auto singlePushers = Backward::move(targetBoard) & allies[Pawn];
+					auto doublePushers = Backward::move(Backward::move(targetBoard) & pieceLocations.empty) & allies[Pawn] & JUMP_RANK;
+					addMovesFrom(singlePushers | doublePushers, Pawn);
+				}
 
-				posData.getAllySquares().allDestSquares |= gen.all();
-				posData.getAllySquares().destSquaresPinConsidered |= gen.all();
+				if (reached) {
+					posData.getAllySquares().destSquaresPinConsidered |= targetBoard;
+				}
 			}
 		}
 
-		static PositionData calcAllLegalMoves(const Position::ImmutableTurnData& turnData) {
+		//only the side to move's legal moves, and the enemy attacks that its king has to respect
+		static PositionData calcLegalMoves(const Position::ImmutableTurnData& turnData) {
 			PositionData ret{ White };
 			auto& allies  = turnData.allies;
 			auto& enemies = turnData.enemies;
-			auto [allySquares, enemySquares] = White ? std::tie(ret.whiteSquares, ret.blackSquares) : std::tie(ret.blackSquares, ret.whiteSquares);
+			auto& enemySquares = ret.getEnemySquares();
 
 			PieceLocationData pieceLocations{ allies[King], allies.calcAllLocations(), enemies.calcAllLocations() };
-			allySquares.allDestSquares = calcNonPinDestSquares(allies, pieceLocations, allyPawnMoveGenerator);
-
 			PieceLocationData pieceLocationsEnemyPOV{ enemies[King], enemies.calcAllLocations(), allies.calcAllLocations() };
 			enemySquares.allDestSquares = calcNonPinDestSquares(enemies, pieceLocationsEnemyPOV, enemyPawnMoveGenerator);
 
 			ret.isCheck = pieceLocations.allyKing & enemySquares.allDestSquares;
-			auto [allyKingSquares, allyKingAttackerData]   = calcFilteredKingMoves<White>(ret.isCheck, enemies, pieceLocations, enemySquares.allDestSquares);
-			auto [enemyKingSquares, enemyKingAttackerData] = calcFilteredKingMoves<!White>(false, allies, pieceLocationsEnemyPOV, allySquares.allDestSquares);
-
-			//kings can't move to the same squares
-			auto sharedKingSquares = allyKingSquares.all() & enemyKingSquares.all();
-			allyKingSquares &= ~sharedKingSquares;
-			enemyKingSquares &= ~sharedKingSquares;
+			auto [allyKingSquares, allyKingAttackerData] = calcFilteredKingMoves<White>(ret.isCheck, enemies, pieceLocations, enemySquares.allDestSquares);
 
 			addCastlingMoves(ret, allyKingSquares, enemySquares.allDestSquares, turnData, pieceLocations);
-			addMoves(ret, nextSquare(pieceLocations.allyKing), allyKingSquares, King, pieceLocations, turnData.enemies, DEFAULT_MOVE_ADDER);
-
-			allySquares.destSquaresPinConsidered |= allyKingSquares.all();
-			enemySquares.destSquaresPinConsidered |= enemyKingSquares.all();
+			addMoves(ret, nextSquare(pieceLocations.allyKing), allyKingSquares, King, pieceLocations, enemies, KING_ADDER);
 
 			if (allyKingAttackerData.hasMultipleAttackers()) { //if there are multiple checks, we have to move the king
 				return ret;
 			}
 
-			auto attackedAllies = enemySquares.allDestSquares & pieceLocations.allies;
-			auto allyPinMap = calcPinnedAllies(allies, enemies, attackedAllies, allyKingAttackerData, pieceLocations);
-
-			auto attackedEnemies = allySquares.allDestSquares & pieceLocations.enemies;
-			auto enemyPinMap = calcPinnedAllies(enemies, allies, attackedEnemies, enemyKingAttackerData, pieceLocations);
-
-			//add ally moves
-			forEachDestSquare<White>(allies, allyPinMap, allyKingAttackerData, pieceLocations, [&](Square square, Piece pieceType, const MoveGen& destSquares) {
-				if (pieceType == Pawn) {
-					addMoves(ret, square, destSquares, pieceType, pieceLocations, enemies, PAWN_ADDER);
-				} else {
-					addMoves(ret, square, destSquares, pieceType, pieceLocations, enemies, DEFAULT_MOVE_ADDER);
-				}
-				allySquares.destSquaresPinConsidered |= destSquares.all();
-			});
+			auto allyPinMasks = calcPinMasks(enemies, allyKingAttackerData, pieceLocations);
+			if (ret.isCheck) {
+				addCheckEvasions(ret, allies, enemies, allyPinMasks, pieceLocations);
+			} else {
+				forEachDestSquare<White>(allies, allyPinMasks, pieceLocations, [&](Square square, Piece pieceType, const MoveGen& destSquares) {
+					if (pieceType == Pawn) {
+						addMoves(ret, square, destSquares, pieceType, pieceLocations, enemies, PAWN_ADDER);
+					} else {
+						addMoves(ret, square, destSquares, pieceType, pieceLocations, enemies, DEFAULT_MOVE_ADDER);
+					}
+				});
+			}
 			if (enemies.doubleJumpedPawn != Square::None) { //todo: add en passant moves to allySquares 
-				addEnPassantMoves(ret, allyPinMap, allyKingAttackerData, enemies, allies[Pawn], enemies.doubleJumpedPawn, pieceLocations);
+				addEnPassantMoves(ret, allyPinMasks, allyKingAttackerData, enemies, allies[Pawn], enemies.doubleJumpedPawn, pieceLocations);
 			}
 
-			//add enemy moves 
-			forEachDestSquare<!White>(enemies, enemyPinMap, enemyKingAttackerData, pieceLocationsEnemyPOV, [&](Square, Piece, const MoveGen& destSquares) {
+			return ret;
+		}
+
+		//the squares the side that just moved could go to if it were its turn, as if it had been generated for real
+		static void addEnemySquares(PositionData& posData, const Position::ImmutableTurnData& turnData) {
+			auto& allies  = turnData.allies;
+			auto& enemies = turnData.enemies;
+			auto& allySquares = posData.getAllySquares();
+			auto& enemySquares = posData.getEnemySquares();
+
+			PieceLocationData pieceLocations{ allies[King], allies.calcAllLocations(), enemies.calcAllLocations() };
+			allySquares.allDestSquares = calcNonPinDestSquares(allies, pieceLocations, allyPawnMoveGenerator);
+
+			PieceLocationData pieceLocationsEnemyPOV{ enemies[King], enemies.calcAllLocations(), allies.calcAllLocations() };
+
+			auto [enemyKingSquares, enemyKingAttackerData] = calcFilteredKingMoves<!White>(false, allies, pieceLocationsEnemyPOV, allySquares.allDestSquares);
+			enemySquares.destSquaresPinConsidered = enemyKingSquares.all();
+
+			auto enemyPinMasks = calcPinMasks(allies, enemyKingAttackerData, pieceLocationsEnemyPOV);
+			forEachDestSquare<!White>(enemies, enemyPinMasks, pieceLocationsEnemyPOV, [&](Square, Piece, const MoveGen& destSquares) {
 				enemySquares.destSquaresPinConsidered |= destSquares.all();
 			});
-
-			return ret;
+			posData.enemySquaresCalculated = true;
 		}
 	};
 
-	template<bool DrawingBitboards>
-	PositionData calcAllLegalMovesImpl(const Position& pos) {
-		auto turnData = pos.getTurnData();
-
-		if (turnData.isWhite) {
+	template<bool DrawingBitboards, typename Action>
+	decltype(auto) visitMoveGenerator(bool isWhite, Action action) {
+		if (isWhite) {
 			using MoveGenerator = MoveGeneratorImpl<true, WhitePawnMoveGenerator, WhitePawnAttackGenerator,
 				BlackPawnMoveGenerator, BlackPawnAttackGenerator, calcRank<8>(), DrawingBitboards>;
-			return MoveGenerator::calcAllLegalMoves(turnData);
+			return action(MoveGenerator{});
 		} else {
 			using MoveGenerator = MoveGeneratorImpl<false, BlackPawnMoveGenerator, BlackPawnAttackGenerator,
 				WhitePawnMoveGenerator, WhitePawnAttackGenerator, calcRank<1>(), DrawingBitboards>;
-			return MoveGenerator::calcAllLegalMoves(turnData);
+			return action(MoveGenerator{});
 		}
 	}
+
+	template<bool DrawingBitboards>
+	PositionData calcAllLegalMovesImpl(const Position& pos) {
+		auto turnData = pos.getTurnData();
+		return visitMoveGenerator<DrawingBitboards>(turnData.isWhite, [&](auto moveGenerator) {
+			auto ret = moveGenerator.calcLegalMoves(turnData);
+			moveGenerator.addEnemySquares(ret, turnData);
+			return ret;
+		});
+	}
 	
 	PositionData calcPositionData(const Position& pos) {
 		return calcAllLegalMovesImpl<false>(pos);
 	}
+	PositionData calcLegalMoves(const Position& pos) {
+		auto turnData = pos.getTurnData();
+		return visitMoveGenerator<false>(turnData.isWhite, [&](auto moveGenerator) {
+			return moveGenerator.calcLegalMoves(turnData);
+		});
+	}
+	void calcEnemySquares(const Position& pos, PositionData& posData) {
+		if (posData.enemySquaresCalculated) {
+			return;
+		}
+		auto turnData = pos.getTurnData();
+		visitMoveGenerator<false>(turnData.isWhite, [&](auto moveGenerator) {
+			moveGenerator.addEnemySquares(posData, turnData);
+		});
+	}
 	PositionData calcPositionDataAndDrawBitboards(const Position& pos) {
 		return calcAllLegalMovesImpl<true>(pos);
 	}
@@ -6,6 +6,12 @@ export import Chess.Move;
 export import Chess.Position;
 
 export namespace chess {
+	//every field filled in, ready for evaluation
 	PositionData calcPositionData(const Position& pos);
 	PositionData calcPositionDataAndDrawBitboards(const Position& pos);
+
+	//only what the side to move needs: its legal moves, whether it's in check, and the squares the enemy attacks
+	PositionData calcLegalMoves(const Position& pos);
+	//fills in the rest of a calcLegalMoves result on demand; does nothing if it already has it
+	void calcEnemySquares(const Position& pos, PositionData& posData);
 }
\ No newline at end of file
@@ -3,5 +3,9 @@ export module Chess.MoveGeneration;
 export import :DestinationSquares;
 export import :LegalMoveGeneration;
 export import :PieceAttackers;
-export import :TableStore;
-export import :RayTable;
\ No newline at end of file
+export import :RayTable;
+export import :KnightMoveGeneration;
+export import :KingMoveGeneration;
+export import :SlidingTables;
+export import :SlidingMoveGenerators;
+export import :KoggeStoneMoveGenerators;
\ No newline at end of file
@@ -62,7 +62,7 @@ namespace chess {
 	}
 
 	void calcKnightAttackers(AttackerData& attackerData, Bitboard attackedPiece, Bitboard enemyKnights) {
-		auto reverseAttacks = knightMoveGenerator(attackedPiece, ~enemyKnights);
+		auto reverseAttacks = knightTableGenerator(attackedPiece, ~enemyKnights);
 		attackerData.attackers[Knight] |= reverseAttacks.nonEmptyDestSquares;
 	}
 
@@ -10,7 +10,7 @@ export import :PieceLocations;
 
 namespace chess {
 	export struct AttackerData {
-		PieceState attackers;
+		PieceBoards attackers;
 		Bitboard rays = 0;
 		Bitboard indirectRays = 0;
 
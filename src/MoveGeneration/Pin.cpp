@@ -1,46 +1,38 @@
 module Chess.MoveGeneration:Pin;
 
-namespace chess {
-	PinData calcPinData(Square allySquare, const PieceState& enemies, const AttackerData& kingAttackerData,
-		const PieceLocationData& pieceLocations)
-	{
-		PinData ret;
-
-		auto newEmpty = pieceLocations.empty | makeBitboard(allySquare);
-		auto newSlidingAttackers = calcSlidingAttackers(enemies, newEmpty, pieceLocations.allyKing);
-		auto newAttacker = newSlidingAttackers.attackers.calcAllLocations() & ~kingAttackerData.attackers.calcAllLocations();
+import :RayTable;
+import :SlidingMoveGenerators;
 
-		if (!newAttacker) { //no new king attackers, piece is not pinned
-			return ret;
+namespace chess {
+	template<SlidingMoveGenerator XRayGenerator>
+	void addPins(PinMasks& masks, Bitboard possiblePinners, const PieceLocationData& pieceLocations, XRayGenerator xRayGenerator) {
+		//look through every ally from the king, so that the first enemy on each ray is the only one that can pin
+		auto xRayEmpty = pieceLocations.empty | pieceLocations.allies;
+		auto pinners = xRayGenerator(pieceLocations.allyKing, xRayEmpty).nonEmptyDestSquares & possiblePinners;
+
+		auto kingSquare = nextSquare(pieceLocations.allyKing);
+		auto pinnerSquare = Square::None;
+		while (nextSquare(pinners, pinnerSquare)) {
+			auto between = getRay(kingSquare, pinnerSquare);
+			auto blockers = between & pieceLocations.allies;
+			if (std::popcount(blockers) != 1) { //a check, or more than one ally in the way
+				continue;
+			}
+			masks.pinned |= blockers;
+			masks.pinRays[masks.pinCount++] = between | makeBitboard(pinnerSquare);
 		}
-		auto newRay = newSlidingAttackers.allRays() & ~kingAttackerData.allRays();
-
-		ret.mustMoveInPinRay = true;
-		ret.pinRay = newRay;
-		ret.pinnerSquare = nextSquare(newAttacker);
-		ret.pinnerPieceType = enemies.findPiece(ret.pinnerSquare);
-
-		return ret;
 	}
 
-	PinMap calcPinnedAllies(const PieceState& allies, const PieceState& enemies, const Bitboard attackedAllies,
-		const AttackerData& kingAttackerData, const PieceLocationData& pieceLocations)
-	{
-		PinMap ret;
+	PinMasks calcPinMasks(const PieceState& enemies, const AttackerData& kingAttackerData, const PieceLocationData& pieceLocations) {
+		PinMasks ret;
 
-		auto calcPinnedAlliesImpl = [&](Bitboard pieces) {
-			auto attackedPieces = pieces & attackedAllies;
-			auto currSquare = Square::None;
-			while (nextSquare(attackedPieces, currSquare)) {
-				ret[currSquare] = calcPinData(currSquare, enemies, kingAttackerData, pieceLocations);
-			}
-		};
-		calcPinnedAlliesImpl(allies[Queen]);
-		calcPinnedAlliesImpl(allies[Rook]);
-		calcPinnedAlliesImpl(allies[Bishop]);
-		calcPinnedAlliesImpl(allies[Knight]);
-		calcPinnedAlliesImpl(allies[Pawn]);
+		addPins(ret, enemies[Rook] | enemies[Queen], pieceLocations, rookMoveGenerator);
+		addPins(ret, enemies[Bishop] | enemies[Queen], pieceLocations, bishopMoveGenerator);
 
+		auto checkers = kingAttackerData.attackers.calcAllLocations();
+		if (checkers) {
+			ret.checkMask = kingAttackerData.rays | checkers;
+		}
 		return ret;
 	}
-}
\ No newline at end of file
+}
@@ -1,5 +1,7 @@
 export module Chess.MoveGeneration:Pin;
 
+import std;
+
 import Chess.PieceType;
 import Chess.Position.PieceState;
 import Chess.Square;
@@ -8,14 +10,33 @@ import :PieceAttackers;
 import :PieceLocations;
 
 export namespace chess {
-	struct PinData {
-		bool mustMoveInPinRay = false;
-		Bitboard pinRay = 0; //does not include the pinner square
-		Square pinnerSquare = Square::None;
-		Piece pinnerPieceType = Piece::None;
+	//what the king's safety allows every ally piece to do, calculated once per side
+	struct PinMasks {
+		static constexpr auto MAX_PINS = 8uz; //one per direction around the king
+
+		Bitboard pinned = 0;
+		Bitboard checkMask = ALL_SQUARES; //squares that capture or block the checking piece; every square when not in check
+		std::array<Bitboard, MAX_PINS> pinRays; //squares between the king and a pinner, plus the pinner
+		size_t pinCount = 0;
+
+		//the squares a piece on square can move to without exposing the king
+		Bitboard getAllowedSquares(Square square) const {
+			auto board = makeBitboard(square);
+			if (!(pinned & board)) {
+				return checkMask;
+			}
+			for (auto i = 0uz; i < pinCount; i++) {
+				if (pinRays[i] & board) {
+					return checkMask & pinRays[i];
+				}
+			}
+			return checkMask;
+		}
+
+		bool isPinned(Square square) const {
+			return pinned & makeBitboard(square);
+		}
 	};
-	using PinMap = SquareMap<PinData>;
 
-	PinMap calcPinnedAllies(const PieceState& allies, const PieceState& enemies, const Bitboard attackedAllies,
-		const AttackerData& kingAttackerData, const PieceLocationData& pieceLocations);
-}
\ No newline at end of file
+	PinMasks calcPinMasks(const PieceState& enemies, const AttackerData& kingAttackerData, const PieceLocationData& pieceLocations);
+}
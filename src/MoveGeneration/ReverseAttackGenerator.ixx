@@ -29,6 +29,7 @@ export namespace chess {
 
 	MAKE_OPPOSITE_DIRECTIONS(whitePawnAttackGenerator, blackPawnAttackGenerator)
 	MAKE_SYMMETRICAL_OPPOSITE_DIRECTION(knightMoveGenerator)
+	MAKE_SYMMETRICAL_OPPOSITE_DIRECTION(knightTableGenerator)
 	MAKE_SYMMETRICAL_OPPOSITE_DIRECTION(bishopMoveGenerator)
 	MAKE_SYMMETRICAL_OPPOSITE_DIRECTION(rookMoveGenerator)
 	MAKE_SYMMETRICAL_OPPOSITE_DIRECTION(queenMoveGenerator)
@@ -0,0 +1,97 @@
+module;
+
+#include <immintrin.h>
+
+export module Chess.MoveGeneration:KoggeStoneMoveGenerators;
+
+import std;
+import Chess.MoveGen;
+
+export import Chess.Bitboard;
+
+namespace chess {
+	//four directions of an occluded fill, one per lane; each lane shifts left, right or not at all
+	struct alignas(32) KoggeStoneDirections {
+		std::array<std::uint64_t, 4> leftShifts;
+		std::array<std::uint64_t, 4> rightShifts;
+		std::array<Bitboard, 4> nonBorders; //the squares a step in the lane's direction can land on without wrapping around the board
+	};
+
+	//north, east, south, west
+	constexpr KoggeStoneDirections ORTHOGONAL_DIRECTIONS{
+		{ 8, 1, 0, 0 },
+		{ 0, 0, 8, 1 },
+		{ ALL_SQUARES, 0xfefefefefefefefe, ALL_SQUARES, 0x7f7f7f7f7f7f7f7f }
+	};
+	//north east, north west, south west, south east
+	constexpr KoggeStoneDirections DIAGONAL_DIRECTIONS{
+		{ 9, 7, 0, 0 },
+		{ 0, 0, 9, 7 },
+		{ 0xfefefefefefefefe, 0x7f7f7f7f7f7f7f7f, 0x7f7f7f7f7f7f7f7f, 0xfefefefefefefefe }
+	};
+
+	_forceinline __m256i loadLanes(const std::array<std::uint64_t, 4>& lanes) {
+		return _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes.data()));
+	}
+
+	_forceinline __m256i shiftLanes(__m256i board, __m256i leftShifts, __m256i rightShifts) {
+		return _mm256_srlv_epi64(_mm256_sllv_epi64(board, leftShifts), rightShifts);
+	}
+
+	//the attacks of every slider in the four directions at once, without looping over the sliders
+	_forceinline __m256i calcOccludedFill(const KoggeStoneDirections& directions, Bitboard sliders, Bitboard empty) {
+		auto left1 = loadLanes(directions.leftShifts);
+		auto right1 = loadLanes(directions.rightShifts);
+		auto nonBorders = loadLanes(directions.nonBorders);
+		auto left2 = _mm256_slli_epi64(left1, 1);
+		auto right2 = _mm256_slli_epi64(right1, 1);
+		auto left4 = _mm256_slli_epi64(left1, 2);
+		auto right4 = _mm256_slli_epi64(right1, 2);
+
+		auto generators = _mm256_set1_epi64x(static_cast<long long>(sliders));
+		auto propagators = _mm256_and_si256(_mm256_set1_epi64x(static_cast<long long>(empty)), nonBorders);
+
+		//each step doubles how far the generators have flooded through the empty squares
+		generators = _mm256_or_si256(generators, _mm256_and_si256(propagators, shiftLanes(generators, left1, right1)));
+		propagators = _mm256_and_si256(propagators, shiftLanes(propagators, left1, right1));
+		generators = _mm256_or_si256(generators, _mm256_and_si256(propagators, shiftLanes(generators, left2, right2)));
+		propagators = _mm256_and_si256(propagators, shiftLanes(propagators, left2, right2));
+		generators = _mm256_or_si256(generators, _mm256_and_si256(propagators, shiftLanes(generators, left4, right4)));
+
+		//one more step reaches the first blocker of each ray
+		return _mm256_and_si256(shiftLanes(generators, left1, right1), nonBorders);
+	}
+
+	_forceinline Bitboard combineLanes(__m256i lanes) {
+		auto halves = _mm_or_si128(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1));
+		return static_cast<Bitboard>(_mm_cvtsi128_si64(halves)) | static_cast<Bitboard>(_mm_extract_epi64(halves, 1));
+	}
+
+	//every square the rooks and queens attack orthogonally and the bishops and queens attack diagonally; needs avx2
+	export _forceinline Bitboard calcKoggeStoneSlidingAttacks(Bitboard rooksAndQueens, Bitboard bishopsAndQueens, Bitboard empty) {
+		auto orthogonal = calcOccludedFill(ORTHOGONAL_DIRECTIONS, rooksAndQueens, empty);
+		auto diagonal = calcOccludedFill(DIAGONAL_DIRECTIONS, bishopsAndQueens, empty);
+		return combineLanes(_mm256_or_si256(orthogonal, diagonal));
+	}
+
+	struct KoggeStoneBishopGenerator {
+		_forceinline MoveGen operator()(Bitboard movingPieces, Bitboard empty) const {
+			auto ret = combineLanes(calcOccludedFill(DIAGONAL_DIRECTIONS, movingPieces, empty));
+			return { ret & empty, ret & ~empty };
+		}
+	};
+
+	struct KoggeStoneRookGenerator {
+		_forceinline MoveGen operator()(Bitboard movingPieces, Bitboard empty) const {
+			auto ret = combineLanes(calcOccludedFill(ORTHOGONAL_DIRECTIONS, movingPieces, empty));
+			return { ret & empty, ret & ~empty };
+		}
+	};
+
+	struct KoggeStoneQueenGenerator {
+		_forceinline MoveGen operator()(Bitboard movingPieces, Bitboard empty) const {
+			auto ret = calcKoggeStoneSlidingAttacks(movingPieces, movingPieces, empty);
+			return { ret & empty, ret & ~empty };
+		}
+	};
+}
\ No newline at end of file
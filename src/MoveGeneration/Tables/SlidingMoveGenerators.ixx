@@ -2,45 +2,79 @@ export module Chess.MoveGeneration:SlidingMoveGenerators;
 
 import :ChainedMoveGenerator;
 import Chess.MoveGen;
-import :TableLoader;
+import :SlidingTables;
+import :KoggeStoneMoveGenerators;
 import Chess.BitboardImage;
 
 namespace chess {
-	_forceinline const MagicMaps<StaticBMI>& getMaps() {
-		static const auto maps = loadMaps();
-		return maps;
-	}
+	//build with CHESS_KOGGE_STONE_SLIDERS defined to generate sliding attacks with avx2 occluded fills instead of the tables
+#ifdef CHESS_KOGGE_STONE_SLIDERS
+	export constexpr bool KOGGE_STONE_SLIDERS_ENABLED = true;
+#else
+	export constexpr bool KOGGE_STONE_SLIDERS_ENABLED = false;
+#endif
 
-	_forceinline MoveGen getSlidingMovesImpl(const SquareMap<StaticBMI>& map, Bitboard movingPieces, Bitboard empty) {
+	template<SlidingAttackBackend Backend, typename Rays>
+	_forceinline Bitboard getSlidingAttacksImpl(const SquareMap<SlidingEntry>& entries, Bitboard movingPieces, Bitboard empty) {
 		Bitboard ret = 0;
 
 		auto currSquare = Square::None;
 		while (nextSquare(movingPieces, currSquare)) {
 			auto blockers = ~empty & ~makeBitboard(currSquare);
-			auto allSquares = map[currSquare][blockers];
+			auto allSquares = lookupSlidingAttacks<Backend, Rays>(entries, currSquare, blockers);
 			ret |= allSquares;
 		}
+		return ret;
+	}
+
+	template<typename Rays>
+	_forceinline MoveGen getSlidingMovesImpl(const SquareMap<SlidingEntry>& entries, Bitboard movingPieces, Bitboard empty) {
+		auto ret = visitSlidingAttackBackend([&](auto backend) {
+			return getSlidingAttacksImpl<decltype(backend)::value, Rays>(entries, movingPieces, empty);
+		});
 		return { ret & empty, ret & ~empty };
 	}
 
 	struct BishopAttackGenerator {
 		_forceinline MoveGen operator()(Bitboard movingPieces, Bitboard empty) const {
-			return getSlidingMovesImpl(getMaps().diagonalMoveMap, movingPieces, empty);
+			return getSlidingMovesImpl<BishopRays>(BISHOP_SLIDING_ENTRIES, movingPieces, empty);
 		}
 	};
-	export constexpr BishopAttackGenerator bishopMoveGenerator;
 
 	struct RookAttackGenerator {
 		_forceinline MoveGen operator()(Bitboard movingPieces, Bitboard empty) const {
-			return getSlidingMovesImpl(getMaps().orthogonalMoveMap, movingPieces, empty);
+			return getSlidingMovesImpl<RookRays>(ROOK_SLIDING_ENTRIES, movingPieces, empty);
 		}
 	};
-	export constexpr RookAttackGenerator rookMoveGenerator;
 
-	export constexpr ChainedMoveGenerator queenMoveGenerator{ bishopMoveGenerator, rookMoveGenerator };
+	constexpr ChainedMoveGenerator tableQueenMoveGenerator{ BishopAttackGenerator{}, RookAttackGenerator{} };
+
+	export constexpr std::conditional_t<KOGGE_STONE_SLIDERS_ENABLED, KoggeStoneBishopGenerator, BishopAttackGenerator> bishopMoveGenerator;
+	export constexpr std::conditional_t<KOGGE_STONE_SLIDERS_ENABLED, KoggeStoneRookGenerator, RookAttackGenerator> rookMoveGenerator;
+	export constexpr auto queenMoveGenerator = [] {
+		if constexpr (KOGGE_STONE_SLIDERS_ENABLED) {
+			return KoggeStoneQueenGenerator{};
+		} else {
+			return tableQueenMoveGenerator;
+		}
+	}();
+
+	//every square the rooks and queens attack orthogonally and the bishops and queens attack diagonally, looked up square by square
+	export Bitboard calcTableSlidingAttacks(Bitboard rooksAndQueens, Bitboard bishopsAndQueens, Bitboard empty) {
+		return RookAttackGenerator{}(rooksAndQueens, empty).all() | BishopAttackGenerator{}(bishopsAndQueens, empty).all();
+	}
+
+	//the whole board attack map of one side's sliders; the occluded fill does all of them in two registers
+	export _forceinline Bitboard calcSlidingAttacks(Bitboard rooksAndQueens, Bitboard bishopsAndQueens, Bitboard empty) {
+		if constexpr (KOGGE_STONE_SLIDERS_ENABLED) {
+			return calcKoggeStoneSlidingAttacks(rooksAndQueens, bishopsAndQueens, empty);
+		} else {
+			return calcTableSlidingAttacks(rooksAndQueens, bishopsAndQueens, empty);
+		}
+	}
 
 	template<typename MoveGenerator>
-	concept SlidingMoveGenerator = std::same_as<BishopAttackGenerator, MoveGenerator> ||
-								   std::same_as<RookAttackGenerator, MoveGenerator> ||
+	concept SlidingMoveGenerator = std::same_as<std::remove_cvref_t<decltype(bishopMoveGenerator)>, MoveGenerator> ||
+								   std::same_as<std::remove_cvref_t<decltype(rookMoveGenerator)>, MoveGenerator> ||
 							       std::same_as<std::remove_cvref_t<decltype(queenMoveGenerator)>, MoveGenerator>;
 }
\ No newline at end of file
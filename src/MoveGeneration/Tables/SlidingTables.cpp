@@ -0,0 +1,192 @@
+module;
+
+#ifdef _WIN64
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+module Chess.MoveGeneration:SlidingTables;
+
+import std;
+
+namespace chess {
+	struct CpuidResult {
+		std::uint32_t eax = 0;
+		std::uint32_t ebx = 0;
+		std::uint32_t ecx = 0;
+		std::uint32_t edx = 0;
+	};
+
+	CpuidResult cpuid(std::uint32_t leaf, std::uint32_t subleaf) {
+		CpuidResult ret;
+#ifdef _WIN64
+		std::array<int, 4> registers{};
+		__cpuidex(registers.data(), static_cast<int>(leaf), static_cast<int>(subleaf));
+		ret = { static_cast<std::uint32_t>(registers[0]), static_cast<std::uint32_t>(registers[1]),
+			static_cast<std::uint32_t>(registers[2]), static_cast<std::uint32_t>(registers[3]) };
+#else
+		__cpuid_count(leaf, subleaf, ret.eax, ret.ebx, ret.ecx, ret.edx);
+#endif
+		return ret;
+	}
+
+	bool isAuthenticAMD() {
+		auto vendor = cpuid(0, 0);
+		return vendor.ebx == 0x68747541 && vendor.edx == 0x69746e65 && vendor.ecx == 0x444d4163; //"Auth" "enti" "cAMD"
+	}
+
+	//the family in the base field, plus the extended family when the base field is saturated
+	std::uint32_t getCpuFamily() {
+		auto signature = cpuid(1, 0).eax;
+		auto family = (signature >> 8) & 0xF;
+		return family == 0xF ? family + ((signature >> 20) & 0xFF) : family;
+	}
+
+	bool isBmi2Supported() {
+		constexpr std::uint32_t BMI2_BIT = 1u << 8; //leaf 7, ebx
+
+		return cpuid(0, 0).eax >= 7 && (cpuid(7, 0).ebx & BMI2_BIT);
+	}
+
+	SlidingAttackBackend detectSlidingAttackBackend() {
+		constexpr std::uint32_t ZEN3_FAMILY = 0x19;
+
+		if (!isBmi2Supported()) {
+			return SlidingAttackBackend::Magic;
+		}
+		//before zen 3, amd ran pext in microcode with a latency that grows with the popcount of the mask
+		if (isAuthenticAMD() && getCpuFamily() < ZEN3_FAMILY) {
+			return SlidingAttackBackend::Magic;
+		}
+		return PREFER_COMPRESSED_SLIDING_TABLES ? SlidingAttackBackend::CompressedPext : SlidingAttackBackend::Pext;
+	}
+
+	//the cpu has to support avx2 and the os has to save the ymm registers on context switches
+	bool isAvx2Supported() {
+		constexpr std::uint32_t OSXSAVE_BIT = 1u << 27; //leaf 1, ecx
+		constexpr std::uint32_t AVX_BIT = 1u << 28; //leaf 1, ecx
+		constexpr std::uint32_t AVX2_BIT = 1u << 5; //leaf 7, ebx
+		constexpr std::uint64_t XMM_AND_YMM_STATE = 0b110;
+
+		if (cpuid(0, 0).eax < 7) {
+			return false;
+		}
+		auto features = cpuid(1, 0).ecx;
+		if (!(features & OSXSAVE_BIT) || !(features & AVX_BIT)) {
+			return false;
+		}
+#ifdef _WIN64
+		auto enabledState = _xgetbv(0);
+#else
+		std::uint32_t eax = 0;
+		std::uint32_t edx = 0;
+		asm volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		auto enabledState = (static_cast<std::uint64_t>(edx) << 32) | eax;
+#endif
+		return (enabledState & XMM_AND_YMM_STATE) == XMM_AND_YMM_STATE && (cpuid(7, 0).ebx & AVX2_BIT);
+	}
+
+	std::string_view getSlidingAttackBackendName(SlidingAttackBackend backend) {
+		switch (backend) {
+		case SlidingAttackBackend::Pext:
+			return "pext";
+		case SlidingAttackBackend::CompressedPext:
+			return "compressed pext";
+		case SlidingAttackBackend::Magic:
+			return "magic";
+		default:
+			return "fallback";
+		}
+	}
+
+	size_t getSlidingTableBytes(SlidingAttackBackend backend) {
+		constexpr auto ENTRY_BYTES = sizeof(ROOK_SLIDING_ENTRIES) + sizeof(BISHOP_SLIDING_ENTRIES);
+		switch (backend) {
+		case SlidingAttackBackend::Pext:
+			return ENTRY_BYTES + sizeof(PEXT_SLIDING_ATTACKS);
+		case SlidingAttackBackend::CompressedPext:
+			return ENTRY_BYTES + sizeof(COMPRESSED_SLIDING_INDICES) + sizeof(UNIQUE_SLIDING_ATTACKS);
+		case SlidingAttackBackend::Magic:
+			return ENTRY_BYTES + sizeof(MAGIC_SLIDING_ATTACKS);
+		default:
+			return 0;
+		}
+	}
+
+	class LruCache {
+	private:
+		std::list<std::uintptr_t> m_lines; //most recently used first
+		std::unordered_map<std::uintptr_t, std::list<std::uintptr_t>::iterator> m_lineLocations;
+		size_t m_capacity = 0;
+	public:
+		explicit LruCache(size_t capacity) : m_capacity{ capacity } {}
+
+		//returns whether the line was cached
+		bool access(std::uintptr_t line) {
+			if (auto it = m_lineLocations.find(line); it != m_lineLocations.end()) {
+				m_lines.splice(m_lines.begin(), m_lines, it->second);
+				return true;
+			}
+			m_lines.push_front(line);
+			m_lineLocations[line] = m_lines.begin();
+			if (m_lines.size() > m_capacity) {
+				m_lineLocations.erase(m_lines.back());
+				m_lines.pop_back();
+			}
+			return false;
+		}
+	};
+
+	//the simulation can run on cpus without bmi2
+	std::uint32_t calcSoftwarePextIndex(const SlidingEntry& entry, Bitboard blockers) {
+		std::uint32_t index = 0;
+		auto bit = 0;
+		auto currSquare = Square::None;
+		auto rays = entry.rays;
+		while (nextSquare(rays, currSquare)) {
+			index |= static_cast<std::uint32_t>((blockers >> static_cast<int>(currSquare)) & 1) << bit++;
+		}
+		return entry.offset + index;
+	}
+
+	SlidingCacheSimulation simulateSlidingTableCache(std::span<const SlidingLookup> lookups, SlidingAttackBackend backend, size_t cacheBytes) {
+		constexpr auto CACHE_LINE_BYTES = 64uz;
+
+		LruCache cache{ cacheBytes / CACHE_LINE_BYTES };
+		std::unordered_set<std::uintptr_t> touchedLines;
+		SlidingCacheSimulation ret;
+		auto read = [&](const void* address) {
+			auto line = reinterpret_cast<std::uintptr_t>(address) / CACHE_LINE_BYTES;
+			ret.accesses++;
+			ret.hits += cache.access(line);
+			touchedLines.insert(line);
+		};
+
+		for (const auto& lookup : lookups) {
+			const auto& entry = (lookup.isRook ? ROOK_SLIDING_ENTRIES : BISHOP_SLIDING_ENTRIES)[lookup.square];
+			switch (backend) {
+			case SlidingAttackBackend::Pext:
+				read(&entry);
+				read(&PEXT_SLIDING_ATTACKS[calcSoftwarePextIndex(entry, lookup.blockers)]);
+				break;
+			case SlidingAttackBackend::CompressedPext: {
+				read(&entry);
+				auto index = calcSoftwarePextIndex(entry, lookup.blockers);
+				read(&COMPRESSED_SLIDING_INDICES[index]);
+				read(&UNIQUE_SLIDING_ATTACKS[entry.uniqueOffset + COMPRESSED_SLIDING_INDICES[index]]);
+				break;
+			}
+			case SlidingAttackBackend::Magic:
+				read(&entry);
+				read(&MAGIC_SLIDING_ATTACKS[entry.getMagicIndex(lookup.blockers)]);
+				break;
+			default:
+				break;
+			}
+		}
+		ret.touchedBytes = touchedLines.size() * CACHE_LINE_BYTES;
+		return ret;
+	}
+}
\ No newline at end of file
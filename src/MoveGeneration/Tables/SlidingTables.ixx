@@ -0,0 +1,275 @@
+module;
+
+#include <immintrin.h>
+
+export module Chess.MoveGeneration:SlidingTables;
+
+import std;
+import Chess.Direction;
+import Chess.RankCalculator;
+import :MagicNumbers;
+
+export import Chess.Square;
+export import Chess.Bitboard;
+
+namespace chess {
+	//build with CHESS_COMPRESSED_SLIDING_TABLES defined to prefer the compressed tables over the plain pext ones
+#ifdef CHESS_COMPRESSED_SLIDING_TABLES
+	constexpr bool PREFER_COMPRESSED_SLIDING_TABLES = true;
+#else
+	constexpr bool PREFER_COMPRESSED_SLIDING_TABLES = false;
+#endif
+
+	export enum class SlidingAttackBackend : std::uint8_t {
+		Pext,
+		CompressedPext, //pext into one byte indices of each square's unique attack sets, under a fifth of the memory
+		Magic, //for cpus without bmi2 and for the ones that implement pext in microcode
+		Fallback //no tables, the rays are walked square by square
+	};
+	export constexpr std::array ALL_SLIDING_ATTACK_BACKENDS{
+		SlidingAttackBackend::Pext,
+		SlidingAttackBackend::CompressedPext,
+		SlidingAttackBackend::Magic,
+		SlidingAttackBackend::Fallback
+	};
+
+	export std::string_view getSlidingAttackBackendName(SlidingAttackBackend backend);
+	export bool isBmi2Supported(); //whether the pext backends can run on this cpu
+	export bool isAvx2Supported(); //whether the kogge-stone sliders can run on this cpu
+	export size_t getSlidingTableBytes(SlidingAttackBackend backend);
+
+	export struct SlidingLookup {
+		Square square = Square::None;
+		Bitboard blockers = 0;
+		bool isRook = true;
+	};
+	export struct SlidingCacheSimulation {
+		std::uint64_t accesses = 0;
+		std::uint64_t hits = 0;
+		size_t touchedBytes = 0; //every cache line read at least once
+	};
+	//replays lookups against a fully associative lru cache of cacheBytes, reading the cache lines the backend's tables would
+	export SlidingCacheSimulation simulateSlidingTableCache(std::span<const SlidingLookup> lookups, SlidingAttackBackend backend, size_t cacheBytes);
+
+	//checks cpuid once, before main
+	SlidingAttackBackend detectSlidingAttackBackend();
+	SlidingAttackBackend slidingAttackBackend = detectSlidingAttackBackend();
+
+	export SlidingAttackBackend getSlidingAttackBackend() {
+		return slidingAttackBackend;
+	}
+	//for benchmarks and tests that compare the backends; nothing may be generating moves meanwhile
+	export void setSlidingAttackBackend(SlidingAttackBackend backend) {
+		slidingAttackBackend = backend;
+	}
+
+	//one square's slice of the attack tables; the pext, magic and compressed index tables use the same offsets
+	//aligned so that a lookup never touches two cache lines for its entry
+	struct alignas(32) SlidingEntry {
+		Bitboard rays = 0; //the squares whose occupancy matters
+		Bitboard magic = 0;
+		std::uint32_t offset = 0;
+		std::uint32_t uniqueOffset = 0; //into the unique attack sets used by the compressed tables
+		std::uint8_t shift = 0;
+
+		std::uint32_t getPextIndex(Bitboard blockers) const {
+			return offset + static_cast<std::uint32_t>(_pext_u64(blockers, rays));
+		}
+		constexpr std::uint32_t getMagicIndex(Bitboard blockers) const {
+			return offset + static_cast<std::uint32_t>(((blockers & rays) * magic) >> shift);
+		}
+	};
+
+	template<dir::Direction Direction>
+	constexpr Bitboard slide(Square square, Bitboard blockers) {
+		Bitboard ret = 0;
+		auto board = makeBitboard(square);
+		while (board) {
+			board = Direction::move(board) & Direction::NON_BORDERS;
+			ret |= board;
+			board &= ~blockers;
+		}
+		return ret;
+	}
+
+	template<dir::Direction... Directions>
+	struct SlidingRays {
+		static constexpr Bitboard calcAttacks(Square square, Bitboard blockers) {
+			return (slide<Directions>(square, blockers) | ...);
+		}
+
+		//the attack sets of a square only differ in how far each ray reaches, so the unique ones are numbered in a mixed radix of the reaches
+		template<dir::Direction Direction>
+		static constexpr std::uint32_t calcRadix(Square square) {
+			return static_cast<std::uint32_t>(std::max(std::popcount(slide<Direction>(square, 0)), 1));
+		}
+		template<dir::Direction Direction>
+		static constexpr std::uint32_t calcReach(Square square, Bitboard blockers) {
+			return static_cast<std::uint32_t>(std::max(std::popcount(slide<Direction>(square, blockers)), 1) - 1);
+		}
+		static constexpr std::uint32_t calcUniqueIndex(Square square, Bitboard blockers) {
+			std::uint32_t index = 0;
+			((index = index * calcRadix<Directions>(square) + calcReach<Directions>(square, blockers)), ...);
+			return index;
+		}
+		static constexpr std::uint32_t countUniqueAttacks(Square square) {
+			return (calcRadix<Directions>(square) * ...);
+		}
+	};
+
+	using RookRays = SlidingRays<dir::sliding::North, dir::sliding::East, dir::sliding::South, dir::sliding::West>;
+	using BishopRays = SlidingRays<dir::sliding::NorthWest, dir::sliding::NorthEast, dir::sliding::SouthWest, dir::sliding::SouthEast>;
+
+	//a piece on the last square of a ray never blocks anything behind it
+	//note: calcFile<N> and calcRank<N> return the n-1th file and rank, respectively
+	constexpr Bitboard trimEdges(Square square, Bitboard rays) {
+		if (fileOf(square) != 0) {
+			rays &= ~calcFile<1>();
+		}
+		if (fileOf(square) != 7) {
+			rays &= ~calcFile<8>();
+		}
+		if (rankOf(square) != 0) {
+			rays &= ~calcRank<1>();
+		}
+		if (rankOf(square) != 7) {
+			rays &= ~calcRank<8>();
+		}
+		return rays;
+	}
+
+	template<typename Rays>
+	constexpr SquareMap<SlidingEntry> makeSlidingEntries(const std::array<Bitboard, 64>& magics, std::uint32_t offset, std::uint32_t uniqueOffset) {
+		SquareMap<SlidingEntry> entries;
+		for (auto square : SQUARE_ARRAY) {
+			auto rays = trimEdges(square, Rays::calcAttacks(square, 0));
+			auto rayCount = std::popcount(rays);
+			entries[square] = { rays, magics[static_cast<size_t>(square)], offset, uniqueOffset, static_cast<std::uint8_t>(64 - rayCount) };
+			offset += 1u << rayCount;
+			uniqueOffset += Rays::countUniqueAttacks(square);
+		}
+		return entries;
+	}
+
+	constexpr std::uint32_t getEndOffset(const SquareMap<SlidingEntry>& entries) {
+		const auto& last = entries[Square::H8];
+		return last.offset + (1u << std::popcount(last.rays));
+	}
+	template<typename Rays>
+	constexpr std::uint32_t getEndUniqueOffset(const SquareMap<SlidingEntry>& entries) {
+		return entries[Square::H8].uniqueOffset + Rays::countUniqueAttacks(Square::H8);
+	}
+
+	constexpr auto ROOK_SLIDING_ENTRIES = makeSlidingEntries<RookRays>(ROOK_MAGICS, 0, 0);
+	constexpr auto BISHOP_SLIDING_ENTRIES = makeSlidingEntries<BishopRays>(BISHOP_MAGICS,
+		getEndOffset(ROOK_SLIDING_ENTRIES), getEndUniqueOffset<RookRays>(ROOK_SLIDING_ENTRIES));
+	constexpr auto SLIDING_ATTACK_COUNT = static_cast<size_t>(getEndOffset(BISHOP_SLIDING_ENTRIES));
+	constexpr auto UNIQUE_SLIDING_ATTACK_COUNT = static_cast<size_t>(getEndUniqueOffset<BishopRays>(BISHOP_SLIDING_ENTRIES));
+	static_assert(SLIDING_ATTACK_COUNT == 102400 + 5248);
+	static_assert(std::ranges::all_of(SQUARE_ARRAY, [](Square square) {
+		return RookRays::countUniqueAttacks(square) <= 256 && BishopRays::countUniqueAttacks(square) <= 256;
+	}), "the compressed indices are one byte");
+
+	using SlidingAttackTable = std::array<Bitboard, SLIDING_ATTACK_COUNT>;
+	using CompressedIndexTable = std::array<std::uint8_t, SLIDING_ATTACK_COUNT>;
+	using UniqueSlidingAttackTable = std::array<Bitboard, UNIQUE_SLIDING_ATTACK_COUNT>;
+
+	//the carry-rippler visits the subsets of the rays in the order of their pext indices
+	template<typename Func>
+	constexpr void forEachBlockerSubset(const SlidingEntry& entry, Func func) {
+		auto pextIndex = entry.offset;
+		auto blockers = 0_bb;
+		do {
+			func(pextIndex++, blockers);
+			blockers = (blockers - entry.rays) & entry.rays;
+		} while (blockers);
+	}
+
+	template<SlidingAttackBackend Backend, typename Rays>
+	constexpr void addAttacks(SlidingAttackTable& table, const SquareMap<SlidingEntry>& entries) {
+		for (auto square : SQUARE_ARRAY) {
+			const auto& entry = entries[square];
+			forEachBlockerSubset(entry, [&](std::uint32_t pextIndex, Bitboard blockers) {
+				auto index = Backend == SlidingAttackBackend::Pext ? pextIndex : entry.getMagicIndex(blockers);
+				table[index] = Rays::calcAttacks(square, blockers);
+			});
+		}
+	}
+
+	template<SlidingAttackBackend Backend>
+	constexpr SlidingAttackTable makeSlidingAttackTable() {
+		SlidingAttackTable table{};
+		addAttacks<Backend, RookRays>(table, ROOK_SLIDING_ENTRIES);
+		addAttacks<Backend, BishopRays>(table, BISHOP_SLIDING_ENTRIES);
+		return table;
+	}
+
+	template<typename Rays>
+	constexpr void addCompressedIndices(CompressedIndexTable& table, const SquareMap<SlidingEntry>& entries) {
+		for (auto square : SQUARE_ARRAY) {
+			forEachBlockerSubset(entries[square], [&](std::uint32_t pextIndex, Bitboard blockers) {
+				table[pextIndex] = static_cast<std::uint8_t>(Rays::calcUniqueIndex(square, blockers));
+			});
+		}
+	}
+
+	constexpr CompressedIndexTable makeCompressedIndexTable() {
+		CompressedIndexTable table{};
+		addCompressedIndices<RookRays>(table, ROOK_SLIDING_ENTRIES);
+		addCompressedIndices<BishopRays>(table, BISHOP_SLIDING_ENTRIES);
+		return table;
+	}
+
+	template<typename Rays>
+	constexpr void addUniqueAttacks(UniqueSlidingAttackTable& table, const SquareMap<SlidingEntry>& entries) {
+		for (auto square : SQUARE_ARRAY) {
+			const auto& entry = entries[square];
+			forEachBlockerSubset(entry, [&](std::uint32_t, Bitboard blockers) {
+				table[entry.uniqueOffset + Rays::calcUniqueIndex(square, blockers)] = Rays::calcAttacks(square, blockers);
+			});
+		}
+	}
+
+	constexpr UniqueSlidingAttackTable makeUniqueSlidingAttackTable() {
+		UniqueSlidingAttackTable table{};
+		addUniqueAttacks<RookRays>(table, ROOK_SLIDING_ENTRIES);
+		addUniqueAttacks<BishopRays>(table, BISHOP_SLIDING_ENTRIES);
+		return table;
+	}
+
+	//constinit, so that running out of constexpr steps fails the build instead of quietly building the tables at startup;
+	//msvc needs /constexpr:steps200000000 for the four of them (about 800k ray steps per table)
+	constinit const SlidingAttackTable PEXT_SLIDING_ATTACKS = makeSlidingAttackTable<SlidingAttackBackend::Pext>();
+	constinit const SlidingAttackTable MAGIC_SLIDING_ATTACKS = makeSlidingAttackTable<SlidingAttackBackend::Magic>();
+	constinit const CompressedIndexTable COMPRESSED_SLIDING_INDICES = makeCompressedIndexTable();
+	constinit const UniqueSlidingAttackTable UNIQUE_SLIDING_ATTACKS = makeUniqueSlidingAttackTable();
+
+	template<SlidingAttackBackend Backend, typename Rays>
+	_forceinline Bitboard lookupSlidingAttacks(const SquareMap<SlidingEntry>& entries, Square square, Bitboard blockers) {
+		const auto& entry = entries[square];
+		if constexpr (Backend == SlidingAttackBackend::Pext) {
+			return PEXT_SLIDING_ATTACKS[entry.getPextIndex(blockers)];
+		} else if constexpr (Backend == SlidingAttackBackend::CompressedPext) {
+			return UNIQUE_SLIDING_ATTACKS[entry.uniqueOffset + COMPRESSED_SLIDING_INDICES[entry.getPextIndex(blockers)]];
+		} else if constexpr (Backend == SlidingAttackBackend::Magic) {
+			return MAGIC_SLIDING_ATTACKS[entry.getMagicIndex(blockers)];
+		} else {
+			return Rays::calcAttacks(square, blockers);
+		}
+	}
+
+	//calls action with the selected backend as a compile time constant, so that callers can branch once outside their loops
+	template<typename Action>
+	_forceinline decltype(auto) visitSlidingAttackBackend(Action action) {
+		switch (slidingAttackBackend) {
+		case SlidingAttackBackend::Pext:
+			return action(std::integral_constant<SlidingAttackBackend, SlidingAttackBackend::Pext>{});
+		case SlidingAttackBackend::CompressedPext:
+			return action(std::integral_constant<SlidingAttackBackend, SlidingAttackBackend::CompressedPext>{});
+		case SlidingAttackBackend::Magic:
+			return action(std::integral_constant<SlidingAttackBackend, SlidingAttackBackend::Magic>{});
+		default:
+			return action(std::integral_constant<SlidingAttackBackend, SlidingAttackBackend::Fallback>{});
+		}
+	}
+}
\ No newline at end of file
@@ -1,7 +0,0 @@
-export module Chess.MoveGeneration:TableLoader;
-
-export import :BMI;
-
-export namespace chess {
-	MagicMaps<StaticBMI> loadMaps();
-}
\ No newline at end of file
@@ -1,5 +0,0 @@
-export module Chess.MoveGeneration:TableStore;
-
-export namespace chess {
-	void storeBMITable();
-}
\ No newline at end of file
@@ -63,10 +63,10 @@ namespace chess {
 	}
 
 	template<typename NonPVMoves>
-	auto orderCapturesAndEvasionsFirst(const Node& node, Bitboard allEnemySquares, NonPVMoves& movePriorities) {
+	auto orderCapturesAndEvasionsFirst(const SearchStack& stack, Bitboard allEnemySquares, NonPVMoves& movePriorities) {
 		std::ranges::subrange ret{ movePriorities.begin(), movePriorities.end() };
 
-		auto turnData = node.getPos().getTurnData();
+		auto turnData = stack.getPos().getTurnData();
 		
 		auto empty = ~(turnData.enemies.calcAllLocations() | turnData.allies.calcAllLocations());
 		for (auto attackedPiece : getTargets(turnData.allies, allEnemySquares)) {
@@ -91,14 +91,14 @@ namespace chess {
 		return std::ranges::subrange{ priorities.begin(), priorities.end() };
 	}
 
-	arena::Vector<MovePriority> getMovePrioritiesImpl(const Node& node, const Move& pvMove, std::span<const Move> killerMoves) {
-		zAssert(node.getRemainingDepth() != 0_su8);
+	arena::Vector<MovePriority> getMovePrioritiesImpl(const SearchStack& stack, const Move& pvMove, std::span<const Move> killerMoves) {
+		zAssert(stack.getRemainingDepth() != 0_su8);
 
-		const auto& posData  = node.getPositionData();
-		auto allEnemySquares = node.getPositionData().allEnemySquares().destSquaresPinConsidered;
+		const auto& posData  = stack.getPositionData();
+		auto allEnemySquares = stack.getPositionData().allEnemySquares().allDestSquares; //pins aside, so that the enemy side never has to be generated
 
 		arena::Vector<MovePriority> priorities{ std::from_range, posData.legalMoves | std::views::transform([&](const Move& move) {
-			return MovePriority{ move, allEnemySquares, node.getRemainingDepth() - 1_su8 };
+			return MovePriority{ move, allEnemySquares, stack.getRemainingDepth() - 1_su8 };
 		}) };
 
 		std::ranges::sort(priorities, [](const MovePriority& a, const MovePriority& b) {
@@ -106,16 +106,16 @@ namespace chess {
 		});
 
 		auto nonPVMoves = movePVMoveToFront(priorities, pvMove);
-		auto nonMaterialMoves = orderCapturesAndEvasionsFirst(node, allEnemySquares, nonPVMoves);
+		auto nonMaterialMoves = orderCapturesAndEvasionsFirst(stack, allEnemySquares, nonPVMoves);
 		auto likelyBadMoves = orderKillerMovesFirst(killerMoves, nonMaterialMoves);
-		applyLateMoveReduction(node.getRemainingDepth(), node.getLevel(), likelyBadMoves);
+		applyLateMoveReduction(stack.getRemainingDepth(), stack.getLevel(), likelyBadMoves);
 
 		zAssert(!priorities.empty());
 
 		return priorities;
 	}
 
-	arena::Vector<MovePriority> getMovePriorities(const Node& node, const Move& pvMove, std::span<const Move> killerMoves) {
-		return getMovePrioritiesImpl(node, pvMove, killerMoves);
+	arena::Vector<MovePriority> getMovePriorities(const SearchStack& stack, const Move& pvMove, std::span<const Move> killerMoves) {
+		return getMovePrioritiesImpl(stack, pvMove, killerMoves);
 	}
 }
\ No newline at end of file
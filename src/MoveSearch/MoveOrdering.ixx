@@ -3,8 +3,8 @@ export module Chess.MoveSearch:MoveOrdering;
 export import Chess.Arena;
 export import Chess.Move;
 export import :MovePriority;
-export import :Node;
+export import :SearchStack;
 
 export namespace chess {
-	arena::Vector<MovePriority> getMovePriorities(const Node& node, const Move& pvMove, std::span<const Move> killerMoves);
+	arena::Vector<MovePriority> getMovePriorities(const SearchStack& stack, const Move& pvMove, std::span<const Move> killerMoves);
 }
\ No newline at end of file
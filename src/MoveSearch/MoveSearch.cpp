@@ -5,7 +5,6 @@ module;
 module Chess.MoveSearch;
 
 import std;
-import BS.thread_pool;
 
 import Chess.Arena;
 import Chess.Assert;
@@ -15,11 +14,15 @@ import Chess.Evaluation;
 import Chess.MoveGeneration;
 import Chess.Position.RepetitionMap;
 import Chess.Rating;
+import Chess.SearchTrace;
+import Chess.Time;
 
 import :MoveOrdering;
 import :MoveHasher;
-import :Node;
 import :PositionTable;
+import :RootMoves;
+import :SearchStack;
+import :SearchStatistics;
 
 namespace chess {
 	class AlphaBeta {
@@ -62,37 +65,133 @@ namespace chess {
 		std::optional<SafeUnsigned<std::uint8_t>> checkmateLevel = std::nullopt;
 	};
 
+	//shared by every searcher of an AsyncSearch; only read with relaxed loads while searching
+	struct SearchControl {
+		using TimePoint = std::chrono::steady_clock::time_point;
+		using Ticks = std::chrono::steady_clock::rep;
+		static constexpr auto NO_DEADLINE = std::numeric_limits<Ticks>::max();
+
+		std::atomic_bool stopRequested = false;
+		std::atomic<std::uint64_t> nodes = 0;
+		std::atomic<Ticks> deadline = NO_DEADLINE; //stored as ticks so that a ponderhit can set it mid-search
+		std::atomic<Ticks> clockStart = 0;
+		std::atomic_bool pondering = false; //the clock only starts on ponderhit
+		bool ponderSearchPending = false; //between expectPonderSearch() and start(), the only time an early ponderhit is kept
+		bool ponderHitRequested = false; //a ponderhit that arrived while the ponder search was pending
+		std::mutex ponderMutex;
+		SearchLimits limits;
+		int rootPieceCount = 0;
+		std::optional<TimeManager> timeManager; //only touched by the main searcher while searching
+		SearchReporter reporter; //only used by the main searcher
+		TimePoint startTime;
+
+		bool isLimitReached() const {
+			if (stopRequested.load(std::memory_order_relaxed)) {
+				return true;
+			}
+			if (limits.nodes && nodes.load(std::memory_order_relaxed) >= *limits.nodes) {
+				return true;
+			}
+			return std::chrono::steady_clock::now().time_since_epoch().count() >= deadline.load(std::memory_order_relaxed);
+		}
+
+		void startClock(TimePoint start) {
+			if (limits.clock) {
+				TimeManager manager{ *limits.clock, rootPieceCount, start }; //the main searcher makes the same one at its next iteration
+				auto hardDeadline = manager.getHardDeadline();
+				if (limits.deadline) {
+					hardDeadline = std::min(hardDeadline, *limits.deadline);
+				}
+				clockStart.store(start.time_since_epoch().count(), std::memory_order_relaxed);
+				deadline.store(hardDeadline.time_since_epoch().count(), std::memory_order_relaxed);
+			}
+			pondering.store(false, std::memory_order_release);
+		}
+
+		void start(const SearchLimits& newLimits, int pieceCount, TimePoint now) {
+			std::scoped_lock l{ ponderMutex };
+			limits = newLimits;
+			rootPieceCount = pieceCount;
+			startTime = now;
+			timeManager.reset();
+			nodes.store(0, std::memory_order_relaxed);
+			deadline.store(limits.deadline ? limits.deadline->time_since_epoch().count() : NO_DEADLINE, std::memory_order_relaxed);
+
+			if (limits.ponder && !ponderHitRequested) {
+				pondering.store(true, std::memory_order_relaxed);
+			} else {
+				startClock(now);
+			}
+			ponderSearchPending = false;
+			ponderHitRequested = false;
+		}
+
+		void finish() {
+			std::scoped_lock l{ ponderMutex };
+			pondering.store(false, std::memory_order_relaxed);
+		}
+
+		void expectPonderSearch() {
+			std::scoped_lock l{ ponderMutex };
+			ponderSearchPending = true;
+			ponderHitRequested = false;
+		}
+
+		void ponderHit() {
+			std::scoped_lock l{ ponderMutex };
+			if (pondering.load(std::memory_order_relaxed)) {
+				startClock(std::chrono::steady_clock::now());
+			} else if (ponderSearchPending) { //a ponderhit after finish() belongs to no search and must not leak into the next one
+				ponderHitRequested = true;
+			}
+		}
+	};
+
 	class Searcher {
 	private:
 		static constexpr SafeUnsigned<std::uint8_t> RANDOMIZATION_CUTOFF{ 3 };
+		static constexpr std::uint64_t STOP_POLL_INTERVAL = 64; //nodes between stop polls, keeps stop latency well under a millisecond
 		std::mt19937 m_urbg;
 		bool m_helper = false;
-		const std::atomic_bool* m_stopRequested;
-
-		static constexpr auto MAX_DEPTH = 30uz;
-		static constexpr auto MAX_KILLER_MOVES = 3uz;
-		struct KillerMoveEntries {
-			std::array<Move, MAX_KILLER_MOVES> killerMoves{};
-			size_t index = 0;
+		SearchControl* m_control;
+		std::chrono::steady_clock::time_point m_firstNodeTime; //stamped once before the first iteration, so it includes the root setup
+		std::uint64_t m_nodes = 0;
+		bool m_stopped = false;
+		bool m_canStop = false; //the first iteration always completes so that there is a move to return
+		SafeUnsigned<std::uint8_t> m_completedDepth = 0_su8;
+		SafeUnsigned<std::uint8_t> m_selectiveDepth = 0_su8;
+		std::chrono::steady_clock::time_point m_lastCurrentMoveReport;
+
+		static constexpr std::chrono::seconds CURRENT_MOVE_DELAY{ 1 }; //quick searches never report currmove
+		static constexpr std::chrono::milliseconds CURRENT_MOVE_INTERVAL{ 100 };
+
+		SearchStack m_stack;
+		RootMoves m_rootMoves; //only ordered by the main searcher, since the helpers shuffle the root anyway
+		SearchTraceRecorder m_tracer; //never opened unless SEARCH_TRACE_ENABLED
+		SearchStatistics m_statistics;
+
+		//MultiPV: the root is searched once per line, excluding the moves of the lines already found
+		struct RootLine {
+			MoveRating rating;
+			std::vector<Move> pv;
 		};
-		std::array<KillerMoveEntries, MAX_DEPTH> m_killerMoves{};
+		size_t m_lineCount = 1;
+		std::vector<Move> m_excludedRootMoves;
+		std::vector<RootLine> m_rootLines; //lines of the last completed iteration, best first
+		std::vector<RootLine> m_pendingRootLines;
 	public:
 		SafeUnsigned<std::uint8_t> depth = 0_su8;
 
-		Searcher(bool helper, const std::atomic_bool* stopRequested)
-			: m_urbg{ std::random_device{}() }, m_helper{ helper }, m_stopRequested{ stopRequested }
+		Searcher(bool helper, SearchControl* control)
+			: m_urbg{ std::random_device{}() }, m_helper{ helper }, m_control{ control }
 		{
-			for (auto& killerMoves : m_killerMoves) {
-				std::ranges::fill(killerMoves.killerMoves, Move::null());
-				killerMoves.index = 0;
-			}
 		}
 
 		Rating getVotingWeight(const MoveRating& moveRating, Rating& worstScore, Rating maxScoreDiff) const {
 			zAssert(maxScoreDiff >= 0_rt);
 
 			auto ret = 1_rt;
-			ret += std::pow(2_rt, static_cast<Rating>(depth.get()));
+			ret += std::pow(2_rt, static_cast<Rating>(m_completedDepth.get()));
 			
 			//give up to 20% boost depending on how good the score is
 			if (maxScoreDiff != 0_rt) {
@@ -106,52 +205,200 @@ namespace chess {
 			return ret;
 		}
 
+		void setLineCount(size_t lineCount) {
+			m_lineCount = m_helper ? 1uz : std::max(lineCount, 1uz); //helpers only need to find the best move
+		}
+
+		void seed(std::uint64_t seed) {
+			m_urbg.seed(static_cast<std::mt19937::result_type>(seed));
+		}
+
 		bool isHelper() const {
 			return m_helper;
 		}
+
+		std::span<const Move> getPrincipalVariation() const {
+			return m_rootLines.empty() ? std::span<const Move>{} : std::span{ m_rootLines.front().pv };
+		}
+
+		std::chrono::steady_clock::time_point getFirstNodeTime() const {
+			return m_firstNodeTime;
+		}
+
+		const SearchStatistics& getStatistics() const {
+			return m_statistics;
+		}
+
+		void openTrace(size_t threadIndex) {
+			m_tracer.open(getSearchTracePath(threadIndex));
+		}
 	private:
-		static bool wouldMakeRepetition(const Position& pos, Move pvMove, const RepetitionMap& repetitionMap) {
-			Position child{ pos, pvMove };
-			auto repetitionCount = repetitionMap.getPositionCount(child) + 1; //add 1 since we haven't actually pushed this position yet
+		bool shouldStop() {
+			m_nodes++;
+			if (m_nodes % STOP_POLL_INTERVAL == 0) {
+				m_control->nodes.fetch_add(STOP_POLL_INTERVAL, std::memory_order_relaxed);
+				if (m_canStop) {
+					m_stopped = m_control->isLimitReached();
+				}
+			}
+			return m_stopped;
+		}
+
+		bool wouldMakeRepetition(Move pvMove) {
+			if (pvMove == Move::null()) {
+				return false;
+			}
+			auto repetitionCount = m_stack.getPositionCountAfter(pvMove) + 1; //add 1 since we haven't actually pushed this position yet
 			return repetitionCount >= 2; //return 2 (not 3) because the opposing player could then make a threefold repetition after this
 		}
 
+		void reportIteration(const Position& pos, SafeUnsigned<std::uint8_t> iterDepth) const {
+			auto time = std::chrono::steady_clock::now() - m_control->startTime;
+
+			SearchInfo info;
+			info.depth = static_cast<int>(iterDepth.get());
+			info.selectiveDepth = static_cast<int>(m_selectiveDepth.get());
+			info.nodes = m_control->nodes.load(std::memory_order_relaxed);
+			info.time = std::chrono::duration_cast<std::chrono::nanoseconds>(time);
+
+			for (const auto& [i, line] : std::views::enumerate(m_rootLines)) {
+				info.multiPV = static_cast<int>(i) + 1;
+				info.score = pos.isWhite() ? line.rating.rating : -line.rating.rating;
+				info.mateIn = std::nullopt;
+				if (line.rating.checkmateLevel) {
+					auto plies = static_cast<int>(line.rating.checkmateLevel->get());
+					info.mateIn = info.score > 0_rt ? (plies + 1) / 2 : -(plies / 2);
+				}
+				info.pv = line.pv;
+				m_control->reporter.onIterationCompleted(info);
+			}
+		}
+
+		bool isExcludedRootMove(Move move) const {
+			return std::ranges::contains(m_excludedRootMoves, move);
+		}
+
+		void reportCurrentMove(Move move, int moveNumber) {
+			auto now = std::chrono::steady_clock::now();
+			if (now - m_control->startTime < CURRENT_MOVE_DELAY || now - m_lastCurrentMoveReport < CURRENT_MOVE_INTERVAL) {
+				return;
+			}
+			m_lastCurrentMoveReport = now;
+			m_control->reporter.onCurrentMove(CurrentMoveInfo{ static_cast<int>(m_stack.getRemainingDepth().get()), move, moveNumber });
+		}
+
+		template<bool Maximizing>
+		MoveRating minimax(AlphaBeta alphaBeta) {
+			if constexpr (SEARCH_TRACE_ENABLED) {
+				m_stack.getTraceInfo() = {};
+				auto ret = searchNode<Maximizing>(alphaBeta);
+				recordTrace(alphaBeta, ret);
+				return ret;
+			} else {
+				return searchNode<Maximizing>(alphaBeta);
+			}
+		}
+
+		void countTTProbe(const std::optional<PositionEntry>& entry) {
+			m_statistics.ttProbes++;
+			if (!entry) {
+				return;
+			}
+			m_statistics.ttHits++;
+			m_statistics.ttUsable += entry->depth >= m_stack.getRemainingDepth();
+			if (entry->bestMove != Move::null() && !std::ranges::contains(m_stack.getPositionData().legalMoves, entry->bestMove)) {
+				m_statistics.ttCollisions++;
+			}
+		}
+
+		void traceTTCutoff(WindowBound bound) {
+			if constexpr (SEARCH_TRACE_ENABLED) {
+				auto& info = m_stack.getTraceInfo();
+				info.ttCutoff = true;
+				info.bound = static_cast<std::uint8_t>(bound);
+			}
+		}
+
+		void recordTrace(AlphaBeta window, const MoveRating& result) {
+			const auto& info = m_stack.getTraceInfo();
+			auto move = m_stack.getMove();
+
+			TraceRecord record;
+			record.hash = m_stack.getPos().hash();
+			record.alpha = window.getAlpha();
+			record.beta = window.getBeta();
+			record.result = result.rating;
+			record.from = move.from;
+			record.to = move.to;
+			record.promotionPiece = move.promotionPiece;
+			record.ply = m_stack.getLevel().get();
+			record.remainingDepth = m_stack.getRemainingDepth().get();
+			record.bound = info.bound;
+			record.cutoffMoveIndex = info.cutoffMoveIndex;
+			record.flags = (info.ttHit ? TraceRecord::TT_HIT : 0) | (info.ttCutoff ? TraceRecord::TT_CUTOFF : 0);
+			m_tracer.record(record);
+		}
+
 		template<bool Maximizing>
-		MoveRating minimax(const Node& node, AlphaBeta alphaBeta) {
-			if (node.getPositionData().legalMoves.empty()) {
+		MoveRating searchNode(AlphaBeta alphaBeta) {
+			m_stack.clearPV();
+			m_selectiveDepth = std::max(m_selectiveDepth, m_stack.getLevel());
+			m_statistics.nodesPerPly[m_stack.getLevel().get()]++;
+
+			if (m_stack.getPositionData().legalMoves.empty()) {
 				MoveRating ret;
 
-				if (node.getPositionData().isCheckmate()) {
+				if (m_stack.getPositionData().isCheckmate()) {
 					ret.rating = checkmatedRating<Maximizing>();
-					ret.checkmateLevel = node.getLevel();
+					ret.checkmateLevel = m_stack.getLevel();
 				}
 				return ret;
 			}
 
-			if (node.getRepetitionMap().getPositionCount(node.getPos()) >= 3) {
+			if (m_stack.getRepetitionMap().getPositionCount(m_stack.getPos()) >= 3) {
 				return { Move::null(), 0_rt, true };
 			}
 
+			//a side that can force a repetition never has to settle for less than a draw
+			auto drawImprovesBound = Maximizing ? alphaBeta.getAlpha() < 0_rt : alphaBeta.getBeta() > 0_rt;
+			if (drawImprovesBound && m_stack.hasUpcomingRepetition()) {
+				alphaBeta.update<Maximizing>(0_rt);
+				if (alphaBeta.canPrune()) {
+					return { Move::null(), 0_rt, true }; //depends on the path, so it can't go in the TT
+				}
+			}
+
 			auto pvMove = Move::null();
 
-			if (m_stopRequested->load()) {
-				return { Move::null(), node.getRating(), false };
+			if (shouldStop()) {
+				return { Move::null(), 0_rt, true }; //the iteration is thrown away, so the rating doesn't matter
 			}
 
-			bool canUseEntry = !(m_helper && node.getLevel() == 0_su8);
+			//excluding root moves changes the result at the root, but not below it
+			bool canUseEntry = !(m_stack.getLevel() == 0_su8 && (m_helper || !m_excludedRootMoves.empty()));
 
-			if (!m_stopRequested->load() && canUseEntry) {
-				if (auto entryRes = getPositionEntry(node.getPos(), node.getRemainingDepth())) {
+			if (canUseEntry) {
+				auto entryRes = probePositionEntry(m_stack.getPos());
+				countTTProbe(entryRes);
+				if (entryRes && entryRes->depth >= m_stack.getRemainingDepth()) {
 					const auto& entry = *entryRes;
 					pvMove = entry.bestMove;
+					if constexpr (SEARCH_TRACE_ENABLED) {
+						m_stack.getTraceInfo().ttHit = true;
+					}
 					
-					if (!wouldMakeRepetition(node.getPos(), entry.bestMove, node.getRepetitionMap()) && entry.depth >= node.getRemainingDepth()) {
+					if (!wouldMakeRepetition(entry.bestMove) && entry.depth >= m_stack.getRemainingDepth()) {
 						switch (entry.bound) {
 						case InWindow:
+							if (entry.bestMove != Move::null()) {
+								m_stack.setPV(entry.bestMove);
+							}
+							traceTTCutoff(InWindow);
 							return { entry.bestMove, entry.rating, false };
 							break;
 						case LowerBound:
 							if (entry.rating >= alphaBeta.getBeta()) {
+								traceTTCutoff(LowerBound);
 								return { entry.bestMove, entry.rating, false };
 							} else {
 								alphaBeta.updateAlpha(entry.rating);
@@ -159,6 +406,7 @@ namespace chess {
 							break;
 						case UpperBound:
 							if (entry.rating <= alphaBeta.getAlpha()) {
+								traceTTCutoff(UpperBound);
 								return { entry.bestMove, entry.rating, false };
 							} else {
 								alphaBeta.updateBeta(entry.rating);
@@ -168,19 +416,20 @@ namespace chess {
 					}
 				}
 			}
-			if (node.isDone()) {
-				return { Move::null(), node.getRating(), false }; //safe to return Move::null(), as node is never done at the root
+			if (m_stack.isDone()) {
+				return { Move::null(), m_stack.getRating(), false }; //safe to return Move::null(), as the stack is never done at the root
 			}
-			return bestChildPosition<Maximizing>(node, pvMove, alphaBeta);
+			return bestChildPosition<Maximizing>(pvMove, alphaBeta);
 		}
 
 		template<bool Maximizing>
-		MoveRating bestChildPosition(const Node& node, const Move& pvMove, AlphaBeta alphaBeta) {
+		MoveRating bestChildPosition(const Move& pvMove, AlphaBeta alphaBeta) {
 			auto originalAlphaBeta = alphaBeta;
 
-			auto& killerMoves = m_killerMoves[node.getLevel().get()];
-			auto movePriorities = getMovePriorities(node, pvMove, std::span{ killerMoves.killerMoves.data(), MAX_KILLER_MOVES });;
-			if (m_helper && node.getLevel() < RANDOMIZATION_CUTOFF) {
+			auto level = static_cast<size_t>(m_stack.getLevel().get());
+			auto useRootMoves = level == 0 && !m_helper && m_rootMoves.isOrdered();
+			auto movePriorities = useRootMoves ? m_rootMoves.getMovePriorities(m_stack.getRemainingDepth()) : getMovePriorities(m_stack, pvMove, m_stack.getKillerMoves());
+			if (m_helper && m_stack.getLevel() < RANDOMIZATION_CUTOFF) {
 				std::ranges::shuffle(movePriorities, m_urbg);
 			}
 
@@ -188,29 +437,57 @@ namespace chess {
 			
 			auto bound = InWindow;
 			bool didNotPrune = true;
+			bool reportCurrentMoves = !m_helper && level == 0 && m_control->reporter.onCurrentMove;
+			auto killerMoves = m_stack.getKillerMoves();
 
-			for (const auto& movePriority : movePriorities) {
-				Node child{ node, movePriority };
-				auto childRating = minimax<!Maximizing>(child, alphaBeta);
+			for (const auto& [moveIndex, movePriority] : std::views::enumerate(movePriorities)) {
+				if (level == 0 && isExcludedRootMove(movePriority.getMove())) {
+					continue;
+				}
+				if (reportCurrentMoves) {
+					reportCurrentMove(movePriority.getMove(), static_cast<int>(moveIndex) + 1);
+				}
+
+				auto isKillerMove = movePriority.getMove().capturedPiece == Piece::None && std::ranges::contains(killerMoves, movePriority.getMove());
+				m_statistics.killerMovesSearched += isKillerMove;
+
+				auto nodesBefore = m_nodes;
+				m_stack.push(movePriority);
+				auto childRating = minimax<!Maximizing>(alphaBeta);
+				m_stack.pop();
+				if (m_stopped) {
+					return { Move::null(), 0_rt, true };
+				}
+				if (level == 0 && !m_helper) {
+					m_rootMoves.onMoveSearched(movePriority.getMove(), childRating.rating, m_nodes - nodesBefore);
+				}
 				
 				if constexpr (Maximizing) {
 					if (childRating.rating > bestRating.rating) {
 						bestRating = childRating;
 						bestRating.move = movePriority.getMove();
+						m_stack.updatePV(bestRating.move);
 					}
 				} else {
 					if (childRating.rating < bestRating.rating) {
 						bestRating = childRating;
 						bestRating.move = movePriority.getMove();
+						m_stack.updatePV(bestRating.move);
 					}
 				}
 
 				alphaBeta.update<Maximizing>(bestRating.rating);
 				if (alphaBeta.canPrune()) {
+					m_statistics.cutoffs++;
+					m_statistics.firstMoveCutoffs += moveIndex == 0;
+					m_statistics.killerCutoffs += isKillerMove;
+
 					//add killer move
 					if (movePriority.getMove().capturedPiece == Piece::None) {
-						killerMoves.killerMoves[killerMoves.index] = movePriority.getMove();
-						killerMoves.index = killerMoves.index + 1 == MAX_KILLER_MOVES ? 0 : killerMoves.index + 1;
+						m_stack.addKillerMove(movePriority.getMove());
+					}
+					if constexpr (SEARCH_TRACE_ENABLED) {
+						m_stack.getTraceInfo().cutoffMoveIndex = static_cast<std::uint8_t>(std::min<std::ptrdiff_t>(moveIndex, NO_CUTOFF - 1));
 					}
 					
 					bound = Maximizing ? LowerBound : UpperBound;
@@ -235,38 +512,115 @@ namespace chess {
 				}
 			}
 
-			if (!bestRating.invalidTTEntry) {
-				PositionEntry newEntry{ bestRating.move, bestRating.rating, node.getRemainingDepth(), bound };
-				storePositionEntry(node.getPos(), newEntry);
+			if constexpr (SEARCH_TRACE_ENABLED) {
+				m_stack.getTraceInfo().bound = static_cast<std::uint8_t>(bound);
+			}
+			if (!bestRating.invalidTTEntry && !(level == 0 && !m_excludedRootMoves.empty())) {
+				PositionEntry newEntry{ bestRating.move, bestRating.rating, m_stack.getRemainingDepth(), bound };
+				storePositionEntry(m_stack.getPos(), newEntry);
 			}
 
-			bestRating.invalidTTEntry = false; //don't propagate repetition flag up the tree (stop requests will be rechecked)
+			bestRating.invalidTTEntry = false; //don't propagate repetition flag up the tree
 			return bestRating;
 		}
 
 		template<bool Maximizing>
-		MoveRating startAlphaBetaSearch(const Position& pos, SafeUnsigned<std::uint8_t> depth, RepetitionMap repetitionMap) {
+		MoveRating startAlphaBetaSearch(SafeUnsigned<std::uint8_t> depth) {
 			AlphaBeta alphaBeta;
-			Node root{ pos, depth, repetitionMap };
-			return minimax<Maximizing>(root, alphaBeta);
+			m_stack.beginIteration(depth);
+			auto ret = minimax<Maximizing>(alphaBeta);
+			m_stack.endIteration();
+			return ret;
+		}
+
+		bool shouldStartNextIteration(SafeUnsigned<std::uint8_t> completedDepth, Rating score, std::chrono::nanoseconds iterationTime) {
+			auto& timeManager = m_control->timeManager;
+			if (!timeManager) {
+				if (!m_control->limits.clock || m_control->pondering.load(std::memory_order_acquire)) {
+					return true;
+				}
+				SearchControl::TimePoint clockStart{ std::chrono::steady_clock::duration{ m_control->clockStart.load(std::memory_order_relaxed) } };
+				timeManager.emplace(*m_control->limits.clock, m_control->rootPieceCount, clockStart);
+			}
+			auto depthInt = static_cast<int>(completedDepth.get());
+			timeManager->onIterationCompleted(depthInt, score, iterationTime);
+			timeManager->onBestMoveStability(m_rootMoves.getStableIterations(), m_rootMoves.getBestMoveMargin());
+			return timeManager->shouldStartNextIteration(depthInt + 1);
+		}
+
+		template<bool Maximizing>
+		MoveRating searchRootLines(SafeUnsigned<std::uint8_t> depth) {
+			m_pendingRootLines.clear();
+			m_excludedRootMoves.clear();
+
+			auto best = startAlphaBetaSearch<Maximizing>(depth);
+			for (auto rating = best; !m_stopped && rating.move != Move::null(); ) {
+				m_pendingRootLines.push_back(RootLine{ rating, std::vector<Move>{ std::from_range, m_stack.getPrincipalVariation() } });
+				if (m_pendingRootLines.size() == m_lineCount) {
+					break;
+				}
+				m_excludedRootMoves.push_back(rating.move);
+				m_statistics.reSearches++;
+				rating = startAlphaBetaSearch<Maximizing>(depth); //full window again, sharing the TT with the earlier passes
+			}
+			m_excludedRootMoves.clear();
+			if (m_stopped) {
+				return best;
+			}
+
+			std::ranges::stable_sort(m_pendingRootLines, [](const RootLine& a, const RootLine& b) {
+				return Maximizing ? a.rating.rating > b.rating.rating : a.rating.rating < b.rating.rating;
+			});
+			std::swap(m_rootLines, m_pendingRootLines);
+			return m_rootLines.empty() ? best : m_rootLines.front().rating;
 		}
 
 		template<bool Maximizing>
-		MoveRating iterativeDeepening(const Position& pos, const RepetitionMap& repetitionMap) {
-			for (auto iterDepth = 1_su8; iterDepth < depth; ++iterDepth) {
+		MoveRating iterativeDeepening(const Position& pos) {
+			m_firstNodeTime = std::chrono::steady_clock::now(); //the root node is searched next
+			MoveRating bestRating;
+			for (auto iterDepth = 1_su8; ; ++iterDepth) {
 				arena::resetThread();
-				startAlphaBetaSearch<Maximizing>(pos, iterDepth, repetitionMap);
+				auto iterationStart = std::chrono::steady_clock::now();
+				auto iterationNodesBefore = m_nodes;
+				m_rootMoves.beginIteration();
+				auto rating = searchRootLines<Maximizing>(iterDepth);
+				if (m_stopped) { //keep the result of the last completed iteration
+					break;
+				}
+				m_rootMoves.endIteration<Maximizing>();
+				m_statistics.iterationNodes[iterDepth.get()] += m_nodes - iterationNodesBefore;
+				bestRating = rating;
+				m_completedDepth = iterDepth;
+				m_canStop = true;
+				if (!m_helper && m_control->reporter.onIterationCompleted) {
+					reportIteration(pos, iterDepth);
+				}
+				if (iterDepth == depth || m_control->isLimitReached()) {
+					break;
+				}
+				if (!m_helper && !shouldStartNextIteration(iterDepth, Maximizing ? rating.rating : -rating.rating, std::chrono::steady_clock::now() - iterationStart)) {
+					m_control->stopRequested.store(true, std::memory_order_relaxed); //the helpers stop with the main searcher
+					break;
+				}
 			}
-			arena::resetThread();
-			return startAlphaBetaSearch<Maximizing>(pos, depth, repetitionMap);
+			return bestRating;
 		}
 	public:
 		MoveRating operator()(const Position& pos, const RepetitionMap& repetitionMap) {
-			if (pos.isWhite()) {
-				return iterativeDeepening<true>(pos, repetitionMap);
-			} else {
-				return iterativeDeepening<false>(pos, repetitionMap);
-			}
+			m_nodes = 0;
+			m_stopped = false;
+			m_canStop = false;
+			m_completedDepth = 0_su8;
+			m_selectiveDepth = 0_su8;
+			m_lastCurrentMoveReport = {};
+			m_rootLines.clear();
+			m_statistics = {};
+			m_stack.setRoot(pos, repetitionMap);
+			m_rootMoves.reset(calcLegalMoves(pos).legalMoves);
+			auto ret = pos.isWhite() ? iterativeDeepening<true>(pos) : iterativeDeepening<false>(pos);
+			m_control->nodes.fetch_add(m_nodes % STOP_POLL_INTERVAL, std::memory_order_relaxed); //flush the last partial batch
+			return ret;
 		}
 	};
 
@@ -274,27 +628,98 @@ namespace chess {
 	constexpr auto MAIN_THREAD_INDEX = 0uz;
 
 	struct AsyncSearchState {
-		BS::thread_pool<> pool{ THREAD_COUNT };
-		std::atomic_bool stopRequested = false;
+		SearchControl control;
 		std::vector<Searcher> searchers;
+		std::vector<MoveRating> results;
+		size_t activeSearchers = 0; //the first activeSearchers workers search, the rest stay parked
+		SearchStatistics statistics; //of the last search
+		std::optional<std::uint64_t> seed;
+
+		//the root published by each go, read by the workers once the generation changes
+		Position rootPos;
+		RepetitionMap rootRepetitionMap;
+		std::chrono::steady_clock::time_point goTime;
+
+		std::atomic<std::uint32_t> generation = 0;
+		std::atomic<std::uint32_t> pendingWorkers = 0;
+		std::atomic_bool quitting = false;
+		std::vector<std::jthread> workers; //declared last so that the workers never outlive the state they read
 
 		AsyncSearchState() {
 			searchers.reserve(THREAD_COUNT);
-			searchers.emplace_back(false, &stopRequested); //insert main thread
+			searchers.emplace_back(false, &control); //insert main thread
 			if (THREAD_COUNT > 1) {
 				for (auto i = 0uz; i < THREAD_COUNT - 1; i++) { //insert helper threads
-					searchers.emplace_back(true, &stopRequested);
+					searchers.emplace_back(true, &control);
 				}
 			}
+			results.resize(searchers.size());
+			activeSearchers = searchers.size();
+
+			//workers park until the first go, so they can be registered after they are started
+			workers.reserve(searchers.size());
+			for (auto i = 0uz; i < searchers.size(); i++) {
+				workers.emplace_back([this, i] { work(i); });
+			}
 
 			//register threads
-			auto threadIDs = pool.get_thread_ids();
-			for (auto threadID : threadIDs) {
-				arena::registerThread(threadID);
+			for (const auto& worker : workers) {
+				arena::registerThread(worker.get_id());
 			}
 			arena::registerThread(std::this_thread::get_id());
 		}
 
+		~AsyncSearchState() {
+			quitting.store(true);
+			control.stopRequested.store(true);
+			generation.fetch_add(1, std::memory_order_release);
+			generation.notify_all();
+			workers.clear(); //join before the searchers are destroyed
+		}
+
+		void work(size_t index) {
+			if constexpr (SEARCH_TRACE_ENABLED) {
+				searchers[index].openTrace(index); //opened by the worker, so that the file pages are first touched by the thread that writes them
+			}
+			auto seenGeneration = 0u;
+			while (true) {
+				generation.wait(seenGeneration, std::memory_order_acquire); //park until the next go
+				seenGeneration = generation.load(std::memory_order_acquire);
+				if (quitting.load()) {
+					return;
+				}
+				if (index >= activeSearchers) {
+					continue;
+				}
+
+				arena::resetThread();
+				results[index] = searchers[index](rootPos, rootRepetitionMap);
+
+				if (pendingWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					pendingWorkers.notify_all();
+				}
+			}
+		}
+
+		std::span<Searcher> getActiveSearchers() {
+			return std::span{ searchers }.first(activeSearchers);
+		}
+		std::span<const Searcher> getActiveSearchers() const {
+			return std::span{ searchers }.first(activeSearchers);
+		}
+		std::span<const MoveRating> getActiveResults() const {
+			return std::span{ results }.first(activeSearchers);
+		}
+
+		void setOptions(const SearchOptions& options) {
+			zAssert(pendingWorkers.load() == 0);
+			activeSearchers = std::clamp(options.threadCount.value_or(searchers.size()), 1uz, searchers.size());
+			seed = options.seed;
+			for (auto& searcher : searchers) {
+				searcher.setLineCount(options.multiPV);
+			}
+		}
+
 		void assignDepths(SafeUnsigned<std::uint8_t> maxDepth) {
 			zAssert(maxDepth >= 1_su8);
 			
@@ -308,6 +733,46 @@ namespace chess {
 				}
 			}
 		}
+
+		void go(const Position& pos, const SearchLimits& limits, const RepetitionMap& repetitionMap) {
+			zAssert(pendingWorkers.load() == 0);
+
+			if (seed) {
+				for (auto&& [i, searcher] : std::views::enumerate(getActiveSearchers())) {
+					searcher.seed(*seed + static_cast<std::uint64_t>(i));
+				}
+			}
+
+			rootPos = pos;
+			rootRepetitionMap.assignRecent(repetitionMap, static_cast<size_t>(pos.getHalfmoveClock()) + 1);
+			goTime = std::chrono::steady_clock::now();
+			control.start(limits, pos.pieceCount(), goTime);
+			control.stopRequested.store(false);
+			pendingWorkers.store(static_cast<std::uint32_t>(activeSearchers), std::memory_order_relaxed);
+
+			generation.fetch_add(1, std::memory_order_release);
+			generation.notify_all();
+		}
+
+		void waitForWorkers() const {
+			auto pending = pendingWorkers.load(std::memory_order_acquire);
+			while (pending != 0) {
+				pendingWorkers.wait(pending, std::memory_order_acquire);
+				pending = pendingWorkers.load(std::memory_order_acquire);
+			}
+		}
+
+		void mergeStatistics() {
+			statistics = {};
+			for (const auto& searcher : getActiveSearchers()) {
+				statistics += searcher.getStatistics();
+			}
+		}
+
+		std::chrono::nanoseconds calcGoLatency() const {
+			auto latestFirstNode = std::ranges::max(getActiveSearchers() | std::views::transform(&Searcher::getFirstNodeTime));
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(latestFirstNode - goTime);
+		}
 	};
 
 	AsyncSearch::AsyncSearch()
@@ -317,7 +782,7 @@ namespace chess {
 
 	//rn2kb1r/4pppp/2p5/p4n2/P2q1PbP/1Pp2N2/3N2P1/R1BKQB1R w kq - 0 15
 
-	Move voteForBestMove(const std::vector<Searcher>& searchers, const std::vector<MoveRating>& moves) {
+	Move voteForBestMove(std::span<const Searcher> searchers, std::span<const MoveRating> moves) {
 		auto anyPathsLeadToCheckmate = std::ranges::any_of(moves, [](const MoveRating& m) {
 			return m.checkmateLevel.has_value();
 		});
@@ -356,20 +821,17 @@ namespace chess {
 		return bestMove;
 	} 
 
-	std::optional<Move> findBestMoveImpl(std::shared_ptr<AsyncSearchState> state, Position pos, SafeUnsigned<std::uint8_t> depth, RepetitionMap repetitionMap) {
-		arena::resetAllThreads();
+	std::optional<Move> findBestMoveImpl(AsyncSearchState& state, const Position& pos, const SearchLimits& limits, const RepetitionMap& repetitionMap) {
+		state.assignDepths(limits.depth);
+		state.go(pos, limits, repetitionMap);
+		state.waitForWorkers();
+		state.control.finish();
+		state.mergeStatistics();
 
-		state->assignDepths(depth);
-		state->stopRequested.store(false);
-
-		auto moveCandidateFutures = state->pool.submit_sequence(0uz, state->searchers.size(), [&](size_t i) {
-			return state->searchers[i](pos, repetitionMap);
-		});
-		
-		auto moveCandidates = moveCandidateFutures.get();
+		auto moveCandidates = state.getActiveResults();
 		zAssert(!moveCandidates.empty());
 
-		//move candidates could contain null moves if a stop was requested, or if there is checkmate
+		//the first iteration always completes, so null moves only show up when the root has no legal moves
 		auto hasNullMove = std::ranges::any_of(moveCandidates, [](const MoveRating& mr) {
 			return mr.move == Move::null();
 		});
@@ -377,15 +839,55 @@ namespace chess {
 			return std::nullopt;
 		}
 
-		return voteForBestMove(state->searchers, moveCandidates);
+		return voteForBestMove(state.getActiveSearchers(), moveCandidates);
 	}
 
-	std::optional<Move> AsyncSearch::findBestMove(const Position& pos, SafeUnsigned<std::uint8_t> depth, const RepetitionMap& repetitionMap) {
+	std::optional<Move> AsyncSearch::findBestMove(const Position& pos, const SearchLimits& limits, const RepetitionMap& repetitionMap) {
 		ZoneScoped;
-		return findBestMoveImpl(m_state, pos, depth, repetitionMap);
+		return findBestMoveImpl(*m_state, pos, limits, repetitionMap);
+	}
+	std::optional<Move> AsyncSearch::findBestMove(const Position& pos, SafeUnsigned<std::uint8_t> depth, const RepetitionMap& repetitionMap) {
+		return findBestMove(pos, SearchLimits{ .depth = depth }, repetitionMap);
 	}
 
 	void AsyncSearch::cancel() {
-		m_state->stopRequested.store(true);
+		m_state->control.stopRequested.store(true, std::memory_order_relaxed);
+	}
+
+	std::chrono::nanoseconds AsyncSearch::getGoLatency() const {
+		return m_state->calcGoLatency();
+	}
+
+	const SearchStatistics& AsyncSearch::getStatistics() const {
+		return m_state->statistics;
+	}
+
+	void AsyncSearch::setOptions(const SearchOptions& options) {
+		m_state->setOptions(options);
+	}
+
+	void AsyncSearch::expectPonderSearch() {
+		m_state->control.expectPonderSearch();
+	}
+
+	void AsyncSearch::ponderHit() {
+		m_state->control.ponderHit();
+	}
+
+	std::vector<Move> AsyncSearch::getPrincipalVariation() const {
+		return std::vector<Move>{ std::from_range, m_state->searchers[MAIN_THREAD_INDEX].getPrincipalVariation() };
+	}
+
+	void AsyncSearch::setReporter(SearchReporter reporter) {
+		zAssert(m_state->pendingWorkers.load() == 0);
+		m_state->control.reporter = std::move(reporter);
+	}
+
+	size_t AsyncSearch::getMaxThreadCount() {
+		return THREAD_COUNT;
+	}
+
+	std::uint64_t AsyncSearch::getNodeCount() const {
+		return m_state->control.nodes.load(std::memory_order_relaxed);
 	}
 }
\ No newline at end of file
@@ -5,20 +5,79 @@ export import std;
 import Chess.Position;
 import Chess.SafeInt;
 import Chess.Position.RepetitionMap;
+import Chess.Time;
 
 export import :MoveSearchTests;
 export import :PositionTable;
+export import :SearchStatistics;
 
 namespace chess {
 	struct AsyncSearchState;
 
+	export struct SearchLimits {
+		SafeUnsigned<std::uint8_t> depth{ 255 };
+		std::optional<std::uint64_t> nodes = std::nullopt;
+		std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt;
+		std::optional<Clock> clock = std::nullopt; //the side to move's clock, turned into a deadline by the time manager
+		bool ponder = false; //search without using the clock until ponderHit()
+	};
+
+	export struct SearchOptions {
+		std::optional<size_t> threadCount = std::nullopt; //every hardware thread when unset
+		std::optional<std::uint64_t> seed = std::nullopt; //helpers seed their move shuffling from std::random_device when unset
+		size_t multiPV = 1; //number of best root moves the main searcher finds and reports
+	};
+
+	export struct SearchInfo {
+		int depth = 0;
+		int selectiveDepth = 0;
+		int multiPV = 1; //rank of this line among the root moves
+		Rating score = 0_rt; //from the perspective of the side to move
+		std::optional<int> mateIn = std::nullopt; //in moves, negative when the side to move is getting mated
+		std::uint64_t nodes = 0;
+		std::chrono::nanoseconds time{ 0 };
+		std::vector<Move> pv;
+	};
+
+	export struct CurrentMoveInfo {
+		int depth = 0;
+		Move move = Move::null();
+		int moveNumber = 0;
+	};
+
+	//called from the main searcher's thread, so both callbacks must return quickly
+	export struct SearchReporter {
+		std::function<void(const SearchInfo&)> onIterationCompleted;
+		std::function<void(const CurrentMoveInfo&)> onCurrentMove;
+	};
+
 	export class AsyncSearch {
 	private:
 		std::shared_ptr<AsyncSearchState> m_state;
 	public:
 		AsyncSearch();
 
+		std::optional<Move> findBestMove(const Position& pos, const SearchLimits& limits, const RepetitionMap& repetitionMap);
 		std::optional<Move> findBestMove(const Position& pos, SafeUnsigned<std::uint8_t> depth, const RepetitionMap& repetitionMap);
 		void cancel();
+		void expectPonderSearch(); //call before findBestMove with limits.ponder, so that a ponderHit() in between is kept for it
+		void ponderHit(); //starts the clock of a ponder search, or of an expected one that hasn't been published yet
+
+		//the main searcher's best line from its last completed iteration
+		std::vector<Move> getPrincipalVariation() const;
+
+		//only call between searches, from the thread that calls findBestMove
+		void setOptions(const SearchOptions& options);
+		void setReporter(SearchReporter reporter);
+		static size_t getMaxThreadCount();
+
+		//nodes searched by every searcher during the last search
+		std::uint64_t getNodeCount() const;
+
+		//time from the last go being published to the slowest worker searching its first node
+		std::chrono::nanoseconds getGoLatency() const;
+
+		//counters of every searcher during the last search, merged once it finished
+		const SearchStatistics& getStatistics() const;
 	};
 }
\ No newline at end of file
@@ -3,6 +3,7 @@ module Chess.MoveSearch:MoveSearchTests;
 import Chess.Position;
 import Chess.PositionCommand;
 import :MoveOrdering;
+import :RootMoves;
 
 namespace chess {
 	namespace tests {
@@ -39,9 +40,37 @@ namespace chess {
 //			printPriorities(priorities);
 		}
 
+		void testRootMoveOrdering() {
+			std::array moves{
+				Move{ Square::G1, Square::F3, Knight, Piece::None },
+				Move{ Square::B1, Square::C3, Knight, Piece::None },
+				Move{ Square::G1, Square::H3, Knight, Piece::None },
+			};
+			RootMoves rootMoves;
+			rootMoves.reset(moves);
+
+			for (auto iteration = 0; iteration < 2; iteration++) {
+				rootMoves.beginIteration();
+				rootMoves.onMoveSearched(moves[0], 0.1_rt, 100);
+				rootMoves.onMoveSearched(moves[1], 0.5_rt, 50);
+				rootMoves.onMoveSearched(moves[2], 0.1_rt, 300);
+				rootMoves.endIteration<true>();
+			}
+
+			//best score first, ties broken by effort
+			auto ordered = rootMoves.get();
+			if (ordered[0].move != moves[1] || ordered[1].move != moves[2] || ordered[2].move != moves[0]) {
+				std::println("testRootMoveOrdering failed: root moves are not ordered by score, then nodes");
+			}
+			if (rootMoves.getStableIterations() != 1 || std::abs(rootMoves.getBestMoveMargin() - 0.4_rt) > 0.001_rt) {
+				std::println("testRootMoveOrdering failed: wrong best move stability");
+			}
+		}
+
 		void runInternalMoveSearchTests() {
 			testMoveOrdering();
 			testMoveOrdering2();
+			testRootMoveOrdering();
 		}
 	}
 }
\ No newline at end of file
@@ -13,12 +13,12 @@ namespace chess {
 
 	PositionMap positionMap;
 
-	std::optional<PositionEntry> getPositionEntry(const Position& pos, SafeUnsigned<std::uint8_t> depth) {
+	std::optional<PositionEntry> probePositionEntry(const Position& pos) {
 		PositionEntry ret;
 		auto found = positionMap.visit(pos.hash(), [&](const auto& kv) {
 			ret = kv.second;
 		});
-		if (!found || ret.depth < depth) {
+		if (!found) {
 			return std::nullopt;
 		}
 		return ret;
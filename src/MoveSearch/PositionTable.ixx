@@ -22,7 +22,7 @@ namespace chess {
 	};
 	using PositionEntryRef = std::reference_wrapper<const PositionEntry>;
 
-	std::optional<PositionEntry> getPositionEntry(const Position& pos, SafeUnsigned<std::uint8_t> depth);
+	std::optional<PositionEntry> probePositionEntry(const Position& pos); //whatever is stored, however shallow
 	void storePositionEntry(const Position& pos, const PositionEntry& entry);
 
 	export void clearTranspositionTable();
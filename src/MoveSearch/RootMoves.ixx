@@ -0,0 +1,98 @@
+export module Chess.MoveSearch:RootMoves;
+
+import Chess.Arena;
+import Chess.Assert;
+export import Chess.Move;
+export import Chess.Rating;
+export import Chess.SafeInt;
+export import :MovePriority;
+
+export namespace chess {
+	struct RootMove {
+		Move move = Move::null();
+		Rating score = 0_rt; //a bound rather than an exact score for every move but the best
+		std::uint64_t nodes = 0; //spent on this move in the last iteration
+		bool searched = false; //in the current iteration
+	};
+
+	//the root moves of one search, kept between iterations and ordered by how the last iteration went
+	class RootMoves {
+	private:
+		std::vector<RootMove> m_moves;
+		Move m_lastBestMove = Move::null();
+		int m_stableIterations = 0;
+	public:
+		void reset(std::span<const Move> legalMoves) {
+			m_moves.assign_range(legalMoves | std::views::transform([](const Move& move) {
+				return RootMove{ move };
+			}));
+			m_lastBestMove = Move::null();
+			m_stableIterations = 0;
+		}
+
+		//true once an iteration has completed
+		bool isOrdered() const {
+			return m_lastBestMove != Move::null();
+		}
+
+		void beginIteration() {
+			for (auto& rootMove : m_moves) {
+				rootMove.searched = false;
+				rootMove.nodes = 0;
+			}
+		}
+
+		void onMoveSearched(const Move& move, Rating score, std::uint64_t nodes) {
+			auto it = std::ranges::find(m_moves, move, &RootMove::move);
+			zAssert(it != m_moves.end());
+			it->score = score;
+			it->nodes += nodes;
+			it->searched = true;
+		}
+
+		//best score first, then the moves whose subtrees took the most effort, since they were the hardest to refute
+		template<bool Maximizing>
+		void endIteration() {
+			if (std::ranges::none_of(m_moves, &RootMove::searched)) {
+				return; //the root came straight from the TT, so there's nothing new to order by
+			}
+			std::ranges::stable_sort(m_moves, [](const RootMove& a, const RootMove& b) {
+				if (a.searched != b.searched) {
+					return a.searched;
+				}
+				if (a.score != b.score) {
+					return Maximizing ? a.score > b.score : a.score < b.score;
+				}
+				return a.nodes > b.nodes;
+			});
+
+			auto bestMove = m_moves.front().move;
+			m_stableIterations = (bestMove == m_lastBestMove) ? m_stableIterations + 1 : 0;
+			m_lastBestMove = bestMove;
+		}
+
+		//every root move in the last iteration's order, searched to the full depth
+		arena::Vector<MovePriority> getMovePriorities(SafeUnsigned<std::uint8_t> remainingDepth) const {
+			return arena::Vector<MovePriority>{ std::from_range, m_moves | std::views::transform([&](const RootMove& rootMove) {
+				return MovePriority{ rootMove.move, remainingDepth - 1_su8 };
+			}) };
+		}
+
+		//iterations in a row that ended with the same best move
+		int getStableIterations() const {
+			return m_stableIterations;
+		}
+
+		//how far ahead of the second best move the best move is, from the perspective of the side to move
+		Rating getBestMoveMargin() const {
+			if (m_moves.size() < 2 || !m_moves[1].searched) {
+				return std::numeric_limits<Rating>::infinity(); //nothing to compare against
+			}
+			return std::abs(m_moves[0].score - m_moves[1].score);
+		}
+
+		std::span<const RootMove> get() const {
+			return m_moves;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+export module Chess.MoveSearch:SearchStack;
+
+import Chess.Arena;
+import Chess.Assert;
+export import Chess.Position;
+export import Chess.Position.RepetitionMap;
+export import Chess.Rating;
+export import Chess.Evaluation;
+export import Chess.MoveGeneration;
+export import Chess.SafeInt;
+export import Chess.SearchTrace;
+export import :MovePriority;
+
+export namespace chess {
+	constexpr auto MAX_PLY = 256uz; //a level is a SafeUnsigned<std::uint8_t>, so no search can go deeper than this
+	constexpr auto MAX_KILLER_MOVES = 3uz;
+
+	//everything the search keeps for one level of the tree
+	struct SearchFrame {
+		PositionData positionData{ true };
+		Position::UndoInfo undo;
+		Move move = Move::null(); //the move that led to this frame
+		SafeUnsigned<std::uint8_t> remainingDepth{ 0 };
+		std::optional<Rating> staticEval = std::nullopt; //computed on first use
+		void* arenaOffset = nullptr;
+
+		std::array<Move, MAX_KILLER_MOVES> killerMoves{};
+		size_t killerIndex = 0;
+
+		//triangular PV: the best line found from this level, starting with this level's move
+		std::array<Move, MAX_PLY> pv{};
+		size_t pvLength = 0;
+
+		TraceNodeInfo trace; //only written when SEARCH_TRACE_ENABLED
+	};
+
+	//one per searcher; the search makes and unmakes moves on a single position instead of copying it at every node
+	class SearchStack {
+	private:
+		Position m_pos;
+		RepetitionMap m_repetitionMap;
+		std::vector<SearchFrame> m_frames = std::vector<SearchFrame>(MAX_PLY);
+		size_t m_level = 0;
+		arena::MemoryRegion* m_memoryRegion = nullptr;
+
+		SearchFrame& frame() {
+			return m_frames[m_level];
+		}
+		const SearchFrame& frame() const {
+			return m_frames[m_level];
+		}
+	public:
+		//called once per search, from the thread that searches
+		void setRoot(const Position& pos, const RepetitionMap& repetitionMap) {
+			m_pos = pos;
+			m_repetitionMap.assignRecent(repetitionMap, static_cast<size_t>(pos.getHalfmoveClock()) + 1); //older positions can't repeat
+			m_repetitionMap.reserve(static_cast<size_t>(pos.getHalfmoveClock()) + 1 + MAX_PLY); //so that pushing never allocates
+			m_level = 0;
+			m_memoryRegion = arena::getMemoryRegion();
+			for (auto& f : m_frames) {
+				std::ranges::fill(f.killerMoves, Move::null());
+				f.killerIndex = 0;
+			}
+		}
+
+		//prepares the root frame for an iteration; the arena is rewound to this point by endIteration()
+		void beginIteration(SafeUnsigned<std::uint8_t> depth) {
+			zAssert(m_level == 0);
+			auto& root = frame();
+			root.arenaOffset = m_memoryRegion->getOffset();
+			root.positionData = calcLegalMoves(m_pos);
+			root.remainingDepth = depth;
+			root.staticEval = std::nullopt;
+			root.move = Move::null();
+		}
+		void endIteration() {
+			zAssert(m_level == 0);
+			m_memoryRegion->resetToOffset(frame().arenaOffset);
+		}
+
+		void push(const MovePriority& movePriority) {
+			zAssert(m_level + 1 < MAX_PLY);
+			auto move = movePriority.getMove();
+			auto undo = m_pos.move(move);
+			m_level++;
+
+			auto& child = frame();
+			child.undo = undo;
+			child.move = move;
+			child.arenaOffset = m_memoryRegion->getOffset();
+			child.positionData = calcLegalMoves(m_pos); //the enemy side is only calculated if the node is evaluated
+			child.remainingDepth = movePriority.getDepth();
+			child.staticEval = std::nullopt;
+			m_repetitionMap.push(m_pos);
+		}
+		void pop() {
+			zAssert(m_level != 0);
+			auto& child = frame();
+			m_repetitionMap.pop(m_pos);
+			m_memoryRegion->resetToOffset(child.arenaOffset);
+			m_pos.unmake(child.move, child.undo);
+			m_level--;
+		}
+
+		//whether the side to move can go back to an earlier position with one reversible move
+		bool hasUpcomingRepetition() const {
+			return m_level != 0 && m_repetitionMap.hasUpcomingRepetition(m_pos, m_level);
+		}
+
+		//how often the position after move has been seen, without pushing a frame for it
+		int getPositionCountAfter(const Move& move) {
+			auto undo = m_pos.move(move);
+			auto count = m_repetitionMap.getPositionCount(m_pos);
+			m_pos.unmake(move, undo);
+			return count;
+		}
+
+		const Position& getPos() const {
+			return m_pos;
+		}
+		const PositionData& getPositionData() const {
+			return frame().positionData;
+		}
+		const RepetitionMap& getRepetitionMap() const {
+			return m_repetitionMap;
+		}
+		const Move& getMove() const {
+			return frame().move;
+		}
+		TraceNodeInfo& getTraceInfo() {
+			return frame().trace;
+		}
+
+		SafeUnsigned<std::uint8_t> getLevel() const {
+			return SafeUnsigned{ static_cast<std::uint8_t>(m_level) };
+		}
+		SafeUnsigned<std::uint8_t> getRemainingDepth() const {
+			return frame().remainingDepth;
+		}
+		bool isDone() const {
+			return frame().remainingDepth == 0_su8;
+		}
+
+		Rating getRating() {
+			auto& f = frame();
+			if (!f.staticEval) {
+				calcEnemySquares(m_pos, f.positionData);
+				f.staticEval = staticEvaluation(m_pos, f.positionData);
+			}
+			return *f.staticEval;
+		}
+
+		std::span<const Move> getKillerMoves() const {
+			return frame().killerMoves;
+		}
+		void addKillerMove(const Move& move) {
+			auto& f = frame();
+			f.killerMoves[f.killerIndex] = move;
+			f.killerIndex = f.killerIndex + 1 == MAX_KILLER_MOVES ? 0 : f.killerIndex + 1;
+		}
+
+		void clearPV() {
+			frame().pvLength = 0;
+		}
+		void setPV(const Move& move) {
+			auto& f = frame();
+			f.pv[0] = move;
+			f.pvLength = 1;
+		}
+		//prepends move to the line just found by the child frame
+		void updatePV(const Move& move) {
+			setPV(move);
+			if (m_level + 1 < MAX_PLY) {
+				auto& f = frame();
+				const auto& child = m_frames[m_level + 1];
+				std::copy_n(child.pv.begin(), child.pvLength, f.pv.begin() + 1);
+				f.pvLength = child.pvLength + 1;
+			}
+		}
+		std::span<const Move> getPrincipalVariation() const {
+			return std::span{ m_frames.front().pv }.first(m_frames.front().pvLength);
+		}
+	};
+}
\ No newline at end of file
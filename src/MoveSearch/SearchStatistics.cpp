@@ -0,0 +1,97 @@
+module Chess.MoveSearch:SearchStatistics;
+
+import nlohmann.json;
+
+namespace chess {
+	constexpr auto STATISTICS_ENTRY_NAME = "searchStatistics";
+
+	double calcPercentage(std::uint64_t part, std::uint64_t total) {
+		return total == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(total);
+	}
+
+	//the deepest ply or iteration with anything counted, plus one
+	size_t calcUsedSize(std::span<const std::uint64_t> counts) {
+		auto last = std::ranges::find_last_if(counts, [](std::uint64_t count) { return count != 0; });
+		return last.empty() ? 0uz : static_cast<size_t>(last.begin() - counts.begin()) + 1;
+	}
+
+	void printSearchStatistics(const SearchStatistics& statistics) {
+		const auto& s = statistics;
+		std::println("{} nodes", s.getNodeCount());
+
+		std::println("{:>5} {:>14}", "ply", "nodes");
+		for (auto ply = 0uz; ply < calcUsedSize(s.nodesPerPly); ply++) {
+			std::println("{:>5} {:>14}", ply, s.nodesPerPly[ply]);
+		}
+
+		std::println("{:>5} {:>14} {:>8}", "depth", "nodes", "ebf");
+		for (auto depth = 1uz; depth < calcUsedSize(s.iterationNodes); depth++) {
+			auto branchingFactor = s.getBranchingFactor(depth);
+			std::println("{:>5} {:>14} {:>8}", depth, s.iterationNodes[depth], branchingFactor ? std::format("{:.2f}", *branchingFactor) : "-");
+		}
+
+		std::println("first move cutoffs: {:.1f}% of {} cutoffs", calcPercentage(s.firstMoveCutoffs, s.cutoffs), s.cutoffs);
+		std::println("tt probes: {}, hit {:.1f}%, usable {:.1f}%, collisions {:.3f}%", s.ttProbes,
+			calcPercentage(s.ttHits, s.ttProbes), calcPercentage(s.ttUsable, s.ttProbes), calcPercentage(s.ttCollisions, s.ttProbes));
+		std::println("killer moves: {} searched, {:.1f}% cut off", s.killerMovesSearched, calcPercentage(s.killerCutoffs, s.killerMovesSearched));
+		std::println("re-searches: {}", s.reSearches);
+	}
+
+	nlohmann::json makeStatisticsEntry(const SearchStatistics& statistics) {
+		const auto& s = statistics;
+		auto nodeCount = s.getNodeCount();
+
+		//same schema as the timed functions, with the plies as children so that the visualizer can show where the nodes went
+		nlohmann::json entry;
+		entry["name"] = STATISTICS_ENTRY_NAME;
+		entry["times_run"] = nodeCount;
+		entry["average_ns"] = 0;
+		nlohmann::json plyPercentages;
+		for (auto ply = 0uz; ply < calcUsedSize(s.nodesPerPly); ply++) {
+			plyPercentages[std::format("ply {}", ply)] = calcPercentage(s.nodesPerPly[ply], nodeCount);
+		}
+		entry["child_percentages"] = plyPercentages;
+
+		nlohmann::json details;
+		details["nodes_per_ply"] = std::vector<std::uint64_t>{ std::from_range, std::span{ s.nodesPerPly }.first(calcUsedSize(s.nodesPerPly)) };
+		auto iterations = nlohmann::json::array();
+		for (auto depth = 1uz; depth < calcUsedSize(s.iterationNodes); depth++) {
+			auto branchingFactor = s.getBranchingFactor(depth);
+			iterations.push_back({
+				{ "depth", depth },
+				{ "nodes", s.iterationNodes[depth] },
+				{ "branching_factor", branchingFactor ? nlohmann::json(*branchingFactor) : nlohmann::json{} }
+			});
+		}
+		details["iterations"] = iterations;
+		details["first_move_cutoff_rate"] = calcPercentage(s.firstMoveCutoffs, s.cutoffs);
+		details["tt_probes"] = s.ttProbes;
+		details["tt_hit_rate"] = calcPercentage(s.ttHits, s.ttProbes);
+		details["tt_usable_rate"] = calcPercentage(s.ttUsable, s.ttProbes);
+		details["tt_collision_rate"] = calcPercentage(s.ttCollisions, s.ttProbes);
+		details["killer_success_rate"] = calcPercentage(s.killerCutoffs, s.killerMovesSearched);
+		details["re_searches"] = s.reSearches;
+		entry["search_statistics"] = details;
+		return entry;
+	}
+
+	void writeSearchStatistics(const SearchStatistics& statistics, const std::filesystem::path& sessionPath) {
+		auto entries = nlohmann::json::array();
+		if (std::ifstream existing{ sessionPath }) {
+			entries = nlohmann::json::parse(existing, nullptr, false);
+			if (!entries.is_array()) {
+				std::println("Error: {} is not a profiling session", sessionPath.string());
+				return;
+			}
+			std::erase_if(entries.get_ref<nlohmann::json::array_t&>(), [](const nlohmann::json& entry) {
+				return entry.value("name", "") == STATISTICS_ENTRY_NAME;
+			});
+		}
+		entries.push_back(makeStatisticsEntry(statistics));
+
+		std::error_code ec;
+		std::filesystem::create_directories(sessionPath.parent_path(), ec);
+		std::ofstream file{ sessionPath };
+		file << entries.dump(2);
+	}
+}
\ No newline at end of file
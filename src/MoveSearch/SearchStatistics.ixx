@@ -0,0 +1,58 @@
+export module Chess.MoveSearch:SearchStatistics;
+
+export import std;
+
+export namespace chess {
+	//counted by each searcher without synchronization, then merged once every searcher has finished
+	struct SearchStatistics {
+		static constexpr auto PLY_COUNT = 256uz; //a level is a SafeUnsigned<std::uint8_t>
+
+		std::array<std::uint64_t, PLY_COUNT> nodesPerPly{};
+		std::array<std::uint64_t, PLY_COUNT> iterationNodes{}; //nodes of each completed iteration, indexed by its depth
+
+		std::uint64_t cutoffs = 0;
+		std::uint64_t firstMoveCutoffs = 0;
+
+		std::uint64_t ttProbes = 0;
+		std::uint64_t ttHits = 0; //an entry was stored for the position
+		std::uint64_t ttUsable = 0; //and it was deep enough to use
+		std::uint64_t ttCollisions = 0; //and its best move isn't legal here, so it belongs to another position
+
+		std::uint64_t killerMovesSearched = 0;
+		std::uint64_t killerCutoffs = 0;
+
+		std::uint64_t reSearches = 0; //extra passes over the root, one per additional MultiPV line
+
+		SearchStatistics& operator+=(const SearchStatistics& other) {
+			std::ranges::transform(nodesPerPly, other.nodesPerPly, nodesPerPly.begin(), std::plus{});
+			std::ranges::transform(iterationNodes, other.iterationNodes, iterationNodes.begin(), std::plus{});
+			cutoffs += other.cutoffs;
+			firstMoveCutoffs += other.firstMoveCutoffs;
+			ttProbes += other.ttProbes;
+			ttHits += other.ttHits;
+			ttUsable += other.ttUsable;
+			ttCollisions += other.ttCollisions;
+			killerMovesSearched += other.killerMovesSearched;
+			killerCutoffs += other.killerCutoffs;
+			reSearches += other.reSearches;
+			return *this;
+		}
+
+		std::uint64_t getNodeCount() const {
+			return std::ranges::fold_left(nodesPerPly, 0ull, std::plus{});
+		}
+
+		//nodes of an iteration over nodes of the one before it
+		std::optional<double> getBranchingFactor(size_t depth) const {
+			if (depth == 0 || depth >= PLY_COUNT || iterationNodes[depth] == 0 || iterationNodes[depth - 1] == 0) {
+				return std::nullopt;
+			}
+			return static_cast<double>(iterationNodes[depth]) / static_cast<double>(iterationNodes[depth - 1]);
+		}
+	};
+
+	void printSearchStatistics(const SearchStatistics& statistics);
+
+	//adds the statistics to a profiling session file as one more entry, replacing the statistics of an earlier run
+	void writeSearchStatistics(const SearchStatistics& statistics, const std::filesystem::path& sessionPath);
+}
\ No newline at end of file
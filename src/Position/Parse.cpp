@@ -29,7 +29,7 @@ namespace chess {
         return piece;
     }
 
-    void parseRow(std::string_view rowStr, std::span<const Square> squareRow, PieceState& whitePieces, PieceState& blackPieces) {
+    void parseRow(std::string_view rowStr, std::span<const Square> squareRow, const MutablePieceState& whitePieces, const MutablePieceState& blackPieces) {
         size_t squareIndex = 0;
 
     	for (auto squareChr : rowStr) {
@@ -39,15 +39,15 @@ namespace chess {
             }
             auto piece = parsePiece(static_cast<char>(std::tolower(static_cast<unsigned char>(squareChr))));
             if (std::islower(static_cast<unsigned char>(squareChr))) {
-                addSquare(blackPieces[piece], squareRow[squareIndex]);
+                blackPieces.addPiece(piece, squareRow[squareIndex]);
             } else {
-                addSquare(whitePieces[piece], squareRow[squareIndex]);
+                whitePieces.addPiece(piece, squareRow[squareIndex]);
             }
             squareIndex++;
         }
     }
 
-    void parseBoard(std::string_view board, PieceState& white, PieceState& black) {
+    void parseBoard(std::string_view board, const MutablePieceState& white, const MutablePieceState& black) {
         auto strRows = board | std::views::split('/') | std::views::transform([](auto&& rng) {
             return std::string_view( rng.data(), rng.size());
         });
@@ -72,8 +72,8 @@ namespace chess {
         }
     }
 
-	void parseCastlingPrivileges(std::string_view castlingPrivileges, PieceState& white, PieceState& black) {
-        auto verify = [&](PieceState& pieces, char king, char queen) {
+	void parseCastlingPrivileges(std::string_view castlingPrivileges, const MutablePieceState& white, const MutablePieceState& black) {
+        auto verify = [&](const MutablePieceState& pieces, char king, char queen) {
             if (!castlingPrivileges.contains(king)) {
                 pieces.castling.disallowKingsideCastling();
             }
@@ -85,11 +85,17 @@ namespace chess {
         verify(black, 'k', 'q');
 	}
 
-    void parseEnPessantSquare(std::string_view enPessantSquareStr, bool isWhite, PieceState& enemies) {
+    void parseEnPessantSquare(std::string_view enPessantSquareStr, bool isWhite, const MutablePieceState& enemies) {
         auto enPessantSquare = parseSquare(enPessantSquareStr);
         if (enPessantSquare) {
             auto jumpedPawn = isWhite ? southSquare(*enPessantSquare) : northSquare(*enPessantSquare);
             enemies.doubleJumpedPawn = jumpedPawn;
         } 
     }
+
+    int parseHalfmoveClock(std::string_view halfmoveClockStr) {
+        auto halfmoveClock = 0;
+        auto [ptr, ec] = std::from_chars(halfmoveClockStr.data(), halfmoveClockStr.data() + halfmoveClockStr.size(), halfmoveClock);
+        return (ec == std::errc{} && halfmoveClock >= 0) ? halfmoveClock : 0;
+    }
 }
\ No newline at end of file
@@ -5,7 +5,8 @@ import Chess.Position.PieceState;
 
 export namespace chess {
 	Piece parsePiece(char chr);
-	void parseBoard(std::string_view board, PieceState& whitePieces, PieceState& blackPieces);
-	void parseCastlingPrivileges(std::string_view castlingPrivileges, PieceState& white, PieceState& black);
-	void parseEnPessantSquare(std::string_view enPessantSquareStr, bool isWhite, PieceState& enemies);
+	void parseBoard(std::string_view board, const MutablePieceState& whitePieces, const MutablePieceState& blackPieces);
+	void parseCastlingPrivileges(std::string_view castlingPrivileges, const MutablePieceState& white, const MutablePieceState& black);
+	void parseEnPessantSquare(std::string_view enPessantSquareStr, bool isWhite, const MutablePieceState& enemies);
+	int parseHalfmoveClock(std::string_view halfmoveClockStr);
 }
\ No newline at end of file
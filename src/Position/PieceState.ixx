@@ -8,23 +8,87 @@ export import Chess.Position.Castling;
 export import Chess.Square;
 
 namespace chess {
-	export struct PieceState : public PieceMap<Bitboard> {
-	private:
-	public:
+	//one bitboard per piece type, nothing else
+	export struct PieceBoards : public PieceMap<Bitboard> {
+		constexpr Bitboard calcAllLocations() const {
+			return m_data[0] | m_data[1] | m_data[2] | m_data[3] | m_data[4] | m_data[5];
+		}
+	};
+
+	//the piece on every square, of either color
+	export using Mailbox = std::array<Piece, 64>;
+	export constexpr Mailbox EMPTY_MAILBOX = [] {
+		Mailbox mailbox;
+		mailbox.fill(Piece::None);
+		return mailbox;
+	}();
+
+	//the pieces of both sides: a board per type and a board per color, so a side's pieces of one type are an and
+	export struct Board {
+		PieceBoards pieces;
+		std::array<Bitboard, 2> colors{}; //white, then black; every square of that side, so occupancy is one load
+		Mailbox mailbox = EMPTY_MAILBOX;
+	};
+	static_assert(sizeof(Board) == 128);
+
+	//what one side owns apart from its pieces
+	export struct SideState {
 		CastlingPrivileges castling;
 		Square doubleJumpedPawn = Square::None;
+	};
 
-		constexpr Bitboard calcAllLocations() const {
-			return m_data[0] | m_data[1] | m_data[2] | m_data[3] | m_data[4] | m_data[5];
+	//one side of a position, seen through the shared board and its own state
+	template<bool Mutable>
+	class BasicPieceState {
+	private:
+		template<typename T>
+		using Ref = std::conditional_t<Mutable, T&, const T&>;
+
+		template<bool>
+		friend class BasicPieceState;
+
+		Ref<Board> m_board;
+		size_t m_color;
+	public:
+		Ref<CastlingPrivileges> castling;
+		Ref<Square> doubleJumpedPawn;
+
+		BasicPieceState(Ref<Board> board, bool isWhite, Ref<SideState> side) :
+			m_board{ board }, m_color{ isWhite ? 0uz : 1uz }, castling{ side.castling }, doubleJumpedPawn{ side.doubleJumpedPawn } {}
+		template<bool OtherMutable> requires (OtherMutable && !Mutable)
+		BasicPieceState(const BasicPieceState<OtherMutable>& other) :
+			m_board{ other.m_board }, m_color{ other.m_color }, castling{ other.castling }, doubleJumpedPawn{ other.doubleJumpedPawn } {}
+
+		Bitboard calcAllLocations() const {
+			return m_board.colors[m_color];
 		}
-		Piece findPiece(Square square) const;
-
-		void clear() {
-			std::ranges::transform(m_data, m_data.begin(), [](auto&) {
-				return 0;
-			});
-			castling.reset();
-			doubleJumpedPawn = Square::None;
+
+		//the mailbox holds both colors, so the occupancy decides whether the piece is ours
+		Piece findPiece(Square square) const {
+			return (calcAllLocations() & makeBitboard(square)) ? m_board.mailbox[static_cast<size_t>(square)] : Piece::None;
+		}
+
+		//the only ways to change the pieces, so that the type boards, the color boards and the mailbox agree
+		void addPiece(Piece piece, Square square) const requires Mutable {
+			addSquare(m_board.pieces[piece], square);
+			addSquare(m_board.colors[m_color], square);
+			m_board.mailbox[static_cast<size_t>(square)] = piece;
+		}
+		void removePiece(Piece piece, Square square) const requires Mutable {
+			removeSquare(m_board.pieces[piece], square);
+			removeSquare(m_board.colors[m_color], square);
+			m_board.mailbox[static_cast<size_t>(square)] = Piece::None;
+		}
+		void movePiece(Piece piece, Square from, Square to) const requires Mutable {
+			removePiece(piece, from);
+			addPiece(piece, to);
+		}
+
+		Bitboard operator[](Piece piece) const {
+			return m_board.pieces[piece] & calcAllLocations();
 		}
 	};
+
+	export using PieceState = BasicPieceState<false>;
+	export using MutablePieceState = BasicPieceState<true>;
 }
\ No newline at end of file
@@ -19,36 +19,31 @@ export namespace chess {
 	};
 	struct PositionData {
 	private:
-		DestinationSquareData* m_allySquares = nullptr;
-		DestinationSquareData* m_enemySquares = nullptr;
+		bool m_isWhite = true; //a flag instead of pointers to the squares, so that copies and moves stay valid
 	public:
 		MoveVector legalMoves;
 		DestinationSquareData whiteSquares;
 		DestinationSquareData blackSquares;
 		
 		bool isCheck = false;
+		bool enemySquaresCalculated = false; //calcLegalMoves leaves the enemy's pin considered squares and the ally's attacks empty
 		
-		constexpr PositionData(bool isWhite) {
-			if (isWhite) {
-				m_allySquares = &whiteSquares;
-				m_enemySquares = &blackSquares;
-			} else {
-				m_allySquares = &blackSquares;
-				m_enemySquares = &whiteSquares;
-			}
+		constexpr PositionData(bool isWhite)
+			: m_isWhite{ isWhite }
+		{
 		}
 		auto& getAllySquares(this auto&& self) {
-			return *self.m_allySquares;
+			return self.m_isWhite ? self.whiteSquares : self.blackSquares;
 		}
 		auto& getEnemySquares(this auto&& self) {
-			return *self.m_enemySquares;
+			return self.m_isWhite ? self.blackSquares : self.whiteSquares;
 		}
 
 		DestinationSquareData allAllySquares() const {
-			return *m_allySquares;
+			return getAllySquares();
 		}
 		DestinationSquareData allEnemySquares() const {
-			return *m_enemySquares;
+			return getEnemySquares();
 		}
 		bool isCheckmate() const {
 			return legalMoves.empty() && isCheck;
@@ -12,118 +12,99 @@ import :Zobrist;
 
 namespace chess {
     void Position::setPos(const PositionCommand& positionCommand) {
-        m_whitePieces.clear();
-        m_blackPieces.clear();
+        m_board = {};
+        m_white = {};
+        m_black = {};
 
-        parseBoard(positionCommand.board, m_whitePieces, m_blackPieces);
+        auto [white, black] = getColorSides();
+        parseBoard(positionCommand.board, white, black);
         m_isWhiteMoving = (positionCommand.color == 'w');
-        parseCastlingPrivileges(positionCommand.castlingPrivileges, m_whitePieces, m_blackPieces);
-        parseEnPessantSquare(positionCommand.enPessantSquare, m_isWhiteMoving, m_isWhiteMoving ? m_blackPieces : m_whitePieces);
+        parseCastlingPrivileges(positionCommand.castlingPrivileges, white, black);
+        parseEnPessantSquare(positionCommand.enPessantSquare, m_isWhiteMoving, m_isWhiteMoving ? black : white);
+        m_halfmoveClock = parseHalfmoveClock(positionCommand.halfmoveClock);
 
         m_zobristHash = getStartingZobristHash(*this);
     }
 
-    bool Position::tryCastle(Position::MutableTurnData& turnData, const Move& move) {
-        //if we can't castle eitherway or we're just not moving the king, don't try to castle
-        if ((!turnData.allies.castling.canCastleKingside() && !turnData.allies.castling.canCastleQueenside()) || move.movedPiece != King) {
-            return false;
-        }
-
+    void Position::castle(const MutableTurnData& turnData, const Move& move) {
         //as soon as we move the king, we can't castle anymore
         turnData.allies.castling.disallowQueensideCastling();
         turnData.allies.castling.disallowKingsideCastling();
 
-        auto updateZobrist = [&move, this](Square rookFrom, Square rookTo) {
-            m_zobristHash ^= getZobristPieceCode(move.from, King, m_isWhiteMoving);
-            m_zobristHash ^= getZobristPieceCode(move.to, King, m_isWhiteMoving);
-            m_zobristHash ^= getZobristPieceCode(rookFrom, Rook, m_isWhiteMoving);
-            m_zobristHash ^= getZobristPieceCode(rookTo, Rook, m_isWhiteMoving);
-        };
-        if (turnData.allyKingside.kingTo == move.to) {
-            moveSquare(turnData.allies[King], move.from, turnData.allyKingside.kingTo);
-            moveSquare(turnData.allies[Rook], turnData.allyKingside.rookFrom, turnData.allyKingside.rookTo);
-            updateZobrist(turnData.allyKingside.rookFrom, turnData.allyKingside.rookTo);
-            return true;
-        } else if (turnData.allyQueenside.kingTo == move.to) {
-            moveSquare(turnData.allies[King], move.from, turnData.allyQueenside.kingTo);
-            moveSquare(turnData.allies[Rook], turnData.allyQueenside.rookFrom, turnData.allyQueenside.rookTo);
-            updateZobrist(turnData.allyQueenside.rookFrom, turnData.allyQueenside.rookTo);
-            return true;
-        }
-        return false;
-    }
-
-    bool isPawnDoubleJump(const Position::MutableTurnData& turnData, const Move& move) {
-        return (makeBitboard(move.from) & turnData.allyPawnRank) && (makeBitboard(move.to) & turnData.jumpedAllyPawnRank);
+        const auto& castle = (turnData.allyKingside.kingTo == move.to) ? turnData.allyKingside : turnData.allyQueenside;
+        turnData.allies.movePiece(King, move.from, castle.kingTo);
+        turnData.allies.movePiece(Rook, castle.rookFrom, castle.rookTo);
+        m_zobristHash ^= getZobristPieceCode(move.from, King, m_isWhiteMoving);
+        m_zobristHash ^= getZobristPieceCode(castle.kingTo, King, m_isWhiteMoving);
+        m_zobristHash ^= getZobristPieceCode(castle.rookFrom, Rook, m_isWhiteMoving);
+        m_zobristHash ^= getZobristPieceCode(castle.rookTo, Rook, m_isWhiteMoving);
     }
 
-    void Position::movePawn(const MutableTurnData& turnData, const Move& move, Bitboard& pawns) {
-        if (isPawnDoubleJump(turnData, move)) {
-            turnData.allies.doubleJumpedPawn = move.to;
-            m_zobristHash ^= getZobristDoubleJumpSquareCode(move.to);
-        }
-        if (move.promotionPiece != Piece::None) {
-            addSquare(turnData.allies[move.promotionPiece], move.to);
-            m_zobristHash ^= getZobristPieceCode(move.to, move.promotionPiece, turnData.isWhite);
-        } else {
-            addSquare(pawns, move.to);
-            m_zobristHash ^= getZobristPieceCode(move.to, move.movedPiece, turnData.isWhite);
+    //moving the king gives up castling on both sides, moving a rook from its starting square on that side
+    void Position::updateAllyCastling(const MutableTurnData& turnData, const Move& move) {
+        if (move.movedPiece == King) {
+            turnData.allies.castling.disallowQueensideCastling();
+            turnData.allies.castling.disallowKingsideCastling();
+        } else if (move.movedPiece == Rook) {
+            if (move.from == turnData.allyKingside.rookFrom) {
+                turnData.allies.castling.disallowKingsideCastling();
+            } else if (move.from == turnData.allyQueenside.rookFrom) {
+                turnData.allies.castling.disallowQueensideCastling();
+            }
         }
     }
 
-    void Position::capturePiece(const MutableTurnData& turnData, const Move& move) {
-        if (move.capturedPiece == Rook) {
-            if (move.to == turnData.enemyKingside.rookFrom) {
+    void Position::removeCapturedPiece(const MutableTurnData& turnData, Piece piece, Square square) {
+        if (piece == Rook) {
+            if (square == turnData.enemyKingside.rookFrom) {
                 turnData.enemies.castling.disallowKingsideCastling();
-            } else if (move.to == turnData.enemyQueenside.rookFrom) {
+            } else if (square == turnData.enemyQueenside.rookFrom) {
                 turnData.enemies.castling.disallowQueensideCastling();
             }
         }
-        if (move.capturedPawnSquareEnPassant == Square::None) {
-            removeSquare(turnData.enemies[move.capturedPiece], move.to);
-            m_zobristHash ^= getZobristPieceCode(move.to, move.capturedPiece, !turnData.isWhite);
-        } else {
-            removeSquare(turnData.enemies[move.capturedPiece], move.capturedPawnSquareEnPassant);
-            m_zobristHash ^= getZobristPieceCode(move.capturedPawnSquareEnPassant, Pawn, !turnData.isWhite);
-        }
+        turnData.enemies.removePiece(piece, square);
+        m_zobristHash ^= getZobristPieceCode(square, piece, !turnData.isWhite);
     }
 
-    void Position::normalMove(MutableTurnData& turnData, const Move& move) {
-        //disallow castling on one side if we are moving a rook from its starting square
-        if (move.movedPiece == Rook) {
-            if (move.from == turnData.allyKingside.rookFrom) {
-                turnData.allies.castling.disallowKingsideCastling();
-            } else if (move.from == turnData.allyQueenside.rookFrom) {
-                turnData.allies.castling.disallowQueensideCastling();
-            }
-        }
+    //one path per kind of move, so that only the work that kind needs is compiled in
+    template<MoveKind Kind>
+    Position::UndoInfo Position::makeMove(const Move& move) {
+        constexpr auto CHANGES_CASTLING = Kind != MoveKind::DoublePush && Kind != MoveKind::EnPassant; //pawn moves that can't capture a rook
 
-        //move the piece (destination square handled with pawn promotions)
-        auto& movedPiecePos = turnData.allies[move.movedPiece];
-        removeSquare(turnData.allies[move.movedPiece], move.from);
-        m_zobristHash ^= getZobristPieceCode(move.from, move.movedPiece, m_isWhiteMoving);
+        auto [white, black] = getColorSides();
+        auto undo = UndoInfo{ white.castling, black.castling, white.doubleJumpedPawn, black.doubleJumpedPawn, m_zobristHash, m_halfmoveClock };
+        auto oldCastlingZobristCode = CHANGES_CASTLING ? getZobristCastleCode(white.castling.get(), black.castling.get()) : 0;
 
-        //capture the piece!
-        if (move.capturedPiece != Piece::None) {
-            capturePiece(turnData, move);
-        }
-       
-        if (move.movedPiece == Pawn) {
-            movePawn(turnData, move, turnData.allies[Pawn]);
+        auto turnData = getTurnData();
+        if constexpr (Kind == MoveKind::Castle) {
+            castle(turnData, move);
         } else {
-            addSquare(movedPiecePos, move.to);
-            m_zobristHash ^= getZobristPieceCode(move.to, move.movedPiece, m_isWhiteMoving);
-        }
-    }
+            if constexpr (Kind == MoveKind::Quiet || Kind == MoveKind::Capture) {
+                updateAllyCastling(turnData, move);
+            }
 
-    void Position::move(const Move& move) {
-        auto [white, black] = getColorSides();
-        auto oldCastlingZobristCode = getZobristCastleCode(white.castling.get(), black.castling.get());
-        auto oldPlayerMover = m_isWhiteMoving;
+            turnData.allies.removePiece(move.movedPiece, move.from);
+            m_zobristHash ^= getZobristPieceCode(move.from, move.movedPiece, m_isWhiteMoving);
+
+            //capture the piece!
+            if constexpr (Kind == MoveKind::Capture) {
+                removeCapturedPiece(turnData, move.capturedPiece, move.to);
+            } else if constexpr (Kind == MoveKind::Promotion) {
+                if (move.capturedPiece != Piece::None) {
+                    removeCapturedPiece(turnData, move.capturedPiece, move.to);
+                }
+            } else if constexpr (Kind == MoveKind::EnPassant) {
+                removeCapturedPiece(turnData, Pawn, move.capturedPawnSquareEnPassant);
+            }
 
-        auto turnData = getTurnData();
-        if (!tryCastle(turnData, move)) {
-            normalMove(turnData, move);
+            auto placedPiece = (Kind == MoveKind::Promotion) ? move.promotionPiece : move.movedPiece;
+            turnData.allies.addPiece(placedPiece, move.to);
+            m_zobristHash ^= getZobristPieceCode(move.to, placedPiece, m_isWhiteMoving);
+
+            if constexpr (Kind == MoveKind::DoublePush) {
+                turnData.allies.doubleJumpedPawn = move.to;
+                m_zobristHash ^= getZobristDoubleJumpSquareCode(move.to);
+            }
         }
 
         //reset enemy jumped pawn
@@ -132,14 +113,84 @@ namespace chess {
             turnData.enemies.doubleJumpedPawn = Square::None;
         }
 
+        if constexpr (Kind == MoveKind::Quiet) {
+            m_halfmoveClock = (move.movedPiece == Pawn) ? 0 : m_halfmoveClock + 1;
+        } else if constexpr (Kind == MoveKind::Castle) {
+            m_halfmoveClock++;
+        } else {
+            m_halfmoveClock = 0;
+        }
+
         //alternate turns
+        m_zobristHash ^= getZobristTurnCode(m_isWhiteMoving);
         m_isWhiteMoving = !m_isWhiteMoving; 
-        m_zobristHash ^= getZobristTurnCode(oldPlayerMover);
         m_zobristHash ^= getZobristTurnCode(m_isWhiteMoving);
 
         //update castling hash
-        m_zobristHash ^= oldCastlingZobristCode;
-        m_zobristHash ^= getZobristCastleCode(white.castling.get(), black.castling.get());
+        if constexpr (CHANGES_CASTLING) {
+            m_zobristHash ^= oldCastlingZobristCode;
+            m_zobristHash ^= getZobristCastleCode(white.castling.get(), black.castling.get());
+        }
+        return undo;
+    }
+
+    Position::UndoInfo Position::move(const Move& move) {
+        switch (move.kind) {
+        case MoveKind::Quiet:
+            return makeMove<MoveKind::Quiet>(move);
+        case MoveKind::Capture:
+            return makeMove<MoveKind::Capture>(move);
+        case MoveKind::DoublePush:
+            return makeMove<MoveKind::DoublePush>(move);
+        case MoveKind::EnPassant:
+            return makeMove<MoveKind::EnPassant>(move);
+        case MoveKind::Castle:
+            return makeMove<MoveKind::Castle>(move);
+        case MoveKind::Promotion:
+            return makeMove<MoveKind::Promotion>(move);
+        }
+        std::unreachable();
+    }
+
+    void Position::unmake(const Move& move, const UndoInfo& undo) {
+        m_isWhiteMoving = !m_isWhiteMoving;
+        auto turnData = getTurnData();
+
+        if (move.kind == MoveKind::Castle) {
+            const auto& castle = (turnData.allyKingside.kingTo == move.to) ? turnData.allyKingside : turnData.allyQueenside;
+            turnData.allies.movePiece(King, castle.kingTo, move.from);
+            turnData.allies.movePiece(Rook, castle.rookTo, castle.rookFrom);
+        } else {
+            auto placedPiece = (move.promotionPiece != Piece::None) ? move.promotionPiece : move.movedPiece;
+            turnData.allies.removePiece(placedPiece, move.to);
+            turnData.allies.addPiece(move.movedPiece, move.from);
+
+            if (move.capturedPiece != Piece::None) {
+                auto capturedSquare = (move.capturedPawnSquareEnPassant == Square::None) ? move.to : move.capturedPawnSquareEnPassant;
+                turnData.enemies.addPiece(move.capturedPiece, capturedSquare);
+            }
+        }
+
+        //everything else is restored wholesale rather than recomputed
+        auto [white, black] = getColorSides();
+        white.castling = undo.whiteCastling;
+        black.castling = undo.blackCastling;
+        white.doubleJumpedPawn = undo.whiteDoubleJumpedPawn;
+        black.doubleJumpedPawn = undo.blackDoubleJumpedPawn;
+        m_zobristHash = undo.zobristHash;
+        m_halfmoveClock = undo.halfmoveClock;
+    }
+
+    std::optional<bool> Position::findReversibleMoveColor(std::uint64_t otherHash) const {
+        auto move = findReversibleMove(m_zobristHash ^ otherHash);
+        if (!move) {
+            return std::nullopt;
+        }
+        auto [white, black] = getColorSides();
+        if (move->between & (white.calcAllLocations() | black.calcAllLocations())) {
+            return std::nullopt;
+        }
+        return move->isWhite;
     }
 
     bool isEnPessant(const Move& move) {
@@ -178,6 +229,7 @@ namespace chess {
         if (moveStr.size() == 5) { //if there is a pawn promotion
             move.promotionPiece = parsePiece(moveStr[4]);
         }
+        move.kind = move.calcKind();
         this->move(move);
     }
 }
\ No newline at end of file
@@ -5,7 +5,6 @@ export import std;
 export import Chess.Move;
 import Chess.PositionCommand;
 import Chess.Position.PieceState;
-import Chess.RankCalculator;
 
 export namespace chess {
 	class Position {
@@ -24,49 +23,66 @@ export namespace chess {
 
 		template<typename MaybeConstPieceState>
 		struct TurnData {
-			MaybeConstPieceState& allies;
-			MaybeConstPieceState& enemies;
+			MaybeConstPieceState allies;
+			MaybeConstPieceState enemies;
 			const CastleMove& allyKingside;
 			const CastleMove& allyQueenside;
 			const CastleMove& enemyKingside;
 			const CastleMove& enemyQueenside;
 			bool isWhite = true;
-			Bitboard allyPawnRank = 0;
-			Bitboard jumpedAllyPawnRank = 0;
 		};
 	public:
-		using MutableTurnData = TurnData<PieceState>;
-		using ImmutableTurnData = TurnData<const PieceState>;
+		using MutableTurnData = TurnData<MutablePieceState>;
+		using ImmutableTurnData = TurnData<PieceState>;
+
+		//everything a move destroys that can't be recomputed from the move itself
+		struct UndoInfo {
+			CastlingPrivileges whiteCastling;
+			CastlingPrivileges blackCastling;
+			Square whiteDoubleJumpedPawn = Square::None;
+			Square blackDoubleJumpedPawn = Square::None;
+			std::uint64_t zobristHash = 0;
+			int halfmoveClock = 0;
+		};
 	private:
-		PieceState m_whitePieces;
-		PieceState m_blackPieces;
-		bool m_isWhiteMoving = true;
+		Board m_board;
 		std::uint64_t m_zobristHash = 0;
+		int m_halfmoveClock = 0; //plies since the last capture or pawn move; no position before that can repeat
+		SideState m_white;
+		SideState m_black;
+		bool m_isWhiteMoving = true;
 
+		PieceState getSide(bool isWhite) const {
+			return { m_board, isWhite, isWhite ? m_white : m_black };
+		}
+		MutablePieceState getSide(bool isWhite) {
+			return { m_board, isWhite, isWhite ? m_white : m_black };
+		}
 		template<typename MaybeConstPieceState>
 		TurnData<MaybeConstPieceState> getTurnDataImpl(this auto&& self) {
+			auto white = self.getSide(true);
+			auto black = self.getSide(false);
 			if (self.m_isWhiteMoving) {
 				return TurnData<MaybeConstPieceState>{
-					self.m_whitePieces, self.m_blackPieces,
+					white, black,
 						WHITE_KINGSIDE, WHITE_QUEENSIDE,
 						BLACK_KINGSIDE, BLACK_QUEENSIDE,
-						self.m_isWhiteMoving,
-						calcRank<2>(), calcRank<4>()
+						self.m_isWhiteMoving
 				};
 			} else {
 				return TurnData<MaybeConstPieceState>{
-					self.m_blackPieces, self.m_whitePieces,
+					black, white,
 						BLACK_KINGSIDE, BLACK_QUEENSIDE,
 						WHITE_KINGSIDE, WHITE_QUEENSIDE,
-						self.m_isWhiteMoving,
-						calcRank<7>(), calcRank<5>()
+						self.m_isWhiteMoving
 				};
 			}
 		}
-		bool tryCastle(MutableTurnData& turnData, const Move& move);
-		void movePawn(const MutableTurnData& turnData, const Move& move, Bitboard& pawns);
-		void capturePiece(const MutableTurnData& turnData, const Move& move);
-		void normalMove(MutableTurnData& turnData, const Move& move);
+		void castle(const MutableTurnData& turnData, const Move& move);
+		void updateAllyCastling(const MutableTurnData& turnData, const Move& move);
+		void removeCapturedPiece(const MutableTurnData& turnData, Piece piece, Square square);
+		template<MoveKind Kind>
+		UndoInfo makeMove(const Move& move);
 	public:
 		Position() = default;
 		Position(Position&&) noexcept = default;
@@ -80,34 +96,41 @@ export namespace chess {
 
 		void setPos(const PositionCommand& positionCommand);
 
-		void move(const Move& move);
+		UndoInfo move(const Move& move);
 		void move(std::string_view moveStr);
+		void unmake(const Move& move, const UndoInfo& undo);
 
 		size_t hash() const {
 			return m_zobristHash;
 		}
 
-		TurnData<const PieceState> getTurnData() const {
-			return getTurnDataImpl<const PieceState>();
-		}
-		TurnData<PieceState> getTurnData() {
+		ImmutableTurnData getTurnData() const {
 			return getTurnDataImpl<PieceState>();
 		}
+		MutableTurnData getTurnData() {
+			return getTurnDataImpl<MutablePieceState>();
+		}
 
 		template<bool Maximizing = true>
-		auto getColorSides(this auto&& self) {
-			if constexpr (Maximizing) {
-				return std::tie(self.m_whitePieces, self.m_blackPieces);
-			}
-			else {
-				return std::tie(self.m_blackPieces, self.m_whitePieces);
-			}
+		std::pair<PieceState, PieceState> getColorSides() const {
+			return { getSide(Maximizing), getSide(!Maximizing) };
+		}
+		template<bool Maximizing = true>
+		std::pair<MutablePieceState, MutablePieceState> getColorSides() {
+			return { getSide(Maximizing), getSide(!Maximizing) };
 		}
 
 		bool isWhite() const {
 			return m_isWhiteMoving;
 		}
 
+		int getHalfmoveClock() const {
+			return m_halfmoveClock;
+		}
+
+		//if one reversible move turns this position into the one with otherHash, returns whether it's white's move
+		std::optional<bool> findReversibleMoveColor(std::uint64_t otherHash) const;
+
 		int pieceCount() const {
 			auto [white, black] = getColorSides();
 			auto whitePieces = white.calcAllLocations();
@@ -126,4 +149,9 @@ export namespace chess {
 			return p1.hash() == p2.hash(); //possibility of a hash duplicate is insanely unlikely 
 		}
 	};
+}
+
+namespace chess {
+	//the eight boards and the mailbox are 128 bytes, and every copy-make copies the whole position
+	static_assert(sizeof(Position) <= 152);
 }
\ No newline at end of file
@@ -1,34 +1,54 @@
-module;
-
-#include <boost/unordered/unordered_flat_map.hpp>
-
 module Chess.Position.RepetitionMap;
 
 import Chess.Assert;
 
 namespace chess {
 	void RepetitionMap::push(const Position& pos) {
-		m_positionCounts[pos.hash()]++;
+		m_hashes.push_back(pos.hash());
 	}
 	void RepetitionMap::pop(const Position& pos) {
-		zAssert(m_positionCounts.contains(pos.hash()));
-		auto& posCount = m_positionCounts.at(pos.hash());
-		zAssert(posCount > 0);
-		posCount--;
+		zAssert(!m_hashes.empty() && m_hashes.back() == pos.hash());
+		m_hashes.pop_back();
 	}
 	int RepetitionMap::getPositionCount(const Position& pos) const {
-		auto positionIt = m_positionCounts.find(pos.hash());
-		if (positionIt == m_positionCounts.end()) {
-			return 0;
+		//+1 for pos itself, when it has already been pushed
+		auto reversiblePlies = std::min(m_hashes.size(), static_cast<size_t>(pos.getHalfmoveClock()) + 1);
+		return static_cast<int>(std::ranges::count(m_hashes | std::views::reverse | std::views::take(reversiblePlies), pos.hash()));
+	}
+	bool RepetitionMap::hasUpcomingRepetition(const Position& pos, size_t level) const {
+		zAssert(!m_hashes.empty() && m_hashes.back() == pos.hash());
+		auto reversiblePlies = std::min(m_hashes.size() - 1, static_cast<size_t>(pos.getHalfmoveClock()));
+
+		//a move changes the side to move, so only every other ply can be one move away, starting 3 plies back
+		for (auto pliesAgo = 3uz; pliesAgo <= reversiblePlies; pliesAgo += 2) {
+			auto earlierHash = m_hashes[m_hashes.size() - 1 - pliesAgo];
+			auto moveColor = pos.findReversibleMoveColor(earlierHash);
+			if (!moveColor) {
+				continue;
+			}
+			if (level > pliesAgo) {
+				return true; //the cycle is inside the search tree, where any repetition is a draw
+			}
+
+			//before the root, the side to move has to make the move, and the position has to come back a third time
+			auto earlierCount = std::ranges::count(m_hashes | std::views::reverse | std::views::take(reversiblePlies + 1), earlierHash);
+			if (*moveColor == pos.isWhite() && earlierCount >= 2) {
+				return true;
+			}
 		}
-		return positionIt->second;
+		return false;
 	}
 	void RepetitionMap::clear() {
-		m_positionCounts.clear();
+		m_hashes.clear();
 	}
 	int RepetitionMap::getTotalPositionCount() const {
-		return std::ranges::fold_left(m_positionCounts, 0, [](auto acc, const auto& kv) {
-			return acc + kv.second;
-		});
+		return static_cast<int>(m_hashes.size());
+	}
+	void RepetitionMap::assignRecent(const RepetitionMap& history, size_t plyCount) {
+		auto count = std::min(plyCount, history.m_hashes.size());
+		m_hashes.assign(history.m_hashes.end() - static_cast<std::ptrdiff_t>(count), history.m_hashes.end());
+	}
+	void RepetitionMap::reserve(size_t plyCount) {
+		m_hashes.reserve(plyCount);
 	}
-}
+}
\ No newline at end of file
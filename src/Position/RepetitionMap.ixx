@@ -1,20 +1,26 @@
-module;
-
-#include <boost/unordered/unordered_flat_map.hpp>
-
 export module Chess.Position.RepetitionMap;
 
 import Chess.Position;
 
 export namespace chess {
+	//the hashes of the positions played so far, indexed by ply
+	//only the plies since the last capture or pawn move are scanned, since no earlier position can come back
 	class RepetitionMap {
 	private:
-		boost::unordered_flat_map<std::uint64_t, int> m_positionCounts;
+		std::vector<std::uint64_t> m_hashes;
 	public:
 		void push(const Position& pos);
 		void pop(const Position& pos);
 		int getPositionCount(const Position& pos) const;
 		void clear();
 		int getTotalPositionCount() const;
+
+		//whether a position on the stack can be reached again with one reversible move, so that the side to move can force a draw
+		//pos has to be the last position pushed, level plies from the root of the search
+		bool hasUpcomingRepetition(const Position& pos, size_t level) const;
+
+		//replaces the contents with the last plyCount positions of history, keeping the allocation
+		void assignRecent(const RepetitionMap& history, size_t plyCount);
+		void reserve(size_t plyCount);
 	};
 }
\ No newline at end of file
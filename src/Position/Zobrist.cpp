@@ -1,7 +1,6 @@
 module Chess.Position:Zobrist;
 
 import Chess.Assert;
-import Chess.EasyRandom;
 import Chess.PieceMap;
 
 import :PositionObject;
@@ -23,8 +22,11 @@ namespace chess {
 	Codes loadCodeMap() {
 		Codes ret;
 
-		auto randomFunc = [] {
-			return makeRandomNum(0uz, std::numeric_limits<std::uint64_t>::max());
+		//fixed seed so that hashes, and with them transposition table collisions, are identical between runs
+		constexpr std::uint64_t ZOBRIST_SEED = 0x9E3779B97F4A7C15;
+		std::mt19937_64 urbg{ ZOBRIST_SEED };
+		auto randomFunc = [&urbg] {
+			return urbg();
 		};
 
 		//make random numbers for the pieces
@@ -69,6 +71,115 @@ namespace chess {
 		return isWhite ? codeMap.whiteToMoveCode : codeMap.blackToMoveCode;
 	}
 
+	//the squares piece passes over going from from to to on an empty board, if it can make that move at all
+	std::optional<Bitboard> calcEmptyBoardPath(Piece piece, Square from, Square to) {
+		auto [fromFile, fromRank] = fileRankOf(from);
+		auto [toFile, toRank] = fileRankOf(to);
+		auto fileDiff = toFile - fromFile;
+		auto rankDiff = toRank - fromRank;
+		auto absFileDiff = std::abs(fileDiff);
+		auto absRankDiff = std::abs(rankDiff);
+
+		auto isStraight = fileDiff == 0 || rankDiff == 0;
+		auto isDiagonal = absFileDiff == absRankDiff;
+		switch (piece) {
+		case Knight:
+			return (absFileDiff * absRankDiff == 2) ? std::optional{ 0_bb } : std::nullopt;
+		case King:
+			return (std::max(absFileDiff, absRankDiff) == 1) ? std::optional{ 0_bb } : std::nullopt;
+		case Rook:
+			if (!isStraight) {
+				return std::nullopt;
+			}
+			break;
+		case Bishop:
+			if (!isDiagonal) {
+				return std::nullopt;
+			}
+			break;
+		case Queen:
+			if (!isStraight && !isDiagonal) {
+				return std::nullopt;
+			}
+			break;
+		default:
+			return std::nullopt;
+		}
+
+		auto between = 0_bb;
+		auto fileStep = (fileDiff > 0) - (fileDiff < 0);
+		auto rankStep = (rankDiff > 0) - (rankDiff < 0);
+		auto file = fromFile + fileStep;
+		auto rank = fromRank + rankStep;
+		while (file != toFile || rank != toRank) {
+			between |= makeBitboard(SQUARE_ARRAY[rank * 8 + file]);
+			file += fileStep;
+			rank += rankStep;
+		}
+		return between;
+	}
+
+	//every reversible move hashed as the difference it makes to a position's hash, including the change of side to move
+	struct CuckooTable {
+		static constexpr size_t SIZE = 8192; //enough for the 3668 moves to be inserted without a cycle
+		std::array<std::uint64_t, SIZE> keys{};
+		std::array<ReversibleMove, SIZE> moves{};
+
+		static constexpr size_t hash1(std::uint64_t key) {
+			return static_cast<size_t>(key) & (SIZE - 1);
+		}
+		static constexpr size_t hash2(std::uint64_t key) {
+			return static_cast<size_t>(key >> 16) & (SIZE - 1);
+		}
+
+		void insert(std::uint64_t key, ReversibleMove move) {
+			auto index = hash1(key);
+			while (true) {
+				std::swap(keys[index], key);
+				std::swap(moves[index], move);
+				if (move.from == Square::None) {
+					return;
+				}
+				index = (index == hash1(key)) ? hash2(key) : hash1(key); //push the evicted entry to its other slot
+			}
+		}
+	};
+
+	CuckooTable loadCuckooTable() {
+		CuckooTable ret;
+
+		constexpr std::array NON_PAWN_PIECES{ King, Queen, Rook, Bishop, Knight };
+		auto turnDifference = getZobristTurnCode(true) ^ getZobristTurnCode(false);
+		for (auto isWhite : { true, false }) {
+			for (auto piece : NON_PAWN_PIECES) {
+				for (auto fromIndex = 0; fromIndex < 64; fromIndex++) {
+					for (auto toIndex = fromIndex + 1; toIndex < 64; toIndex++) {
+						auto from = SQUARE_ARRAY[fromIndex];
+						auto to = SQUARE_ARRAY[toIndex];
+						auto between = calcEmptyBoardPath(piece, from, to);
+						if (!between) {
+							continue;
+						}
+						auto key = getZobristPieceCode(from, piece, isWhite) ^ getZobristPieceCode(to, piece, isWhite) ^ turnDifference;
+						ret.insert(key, ReversibleMove{ from, to, *between, isWhite });
+					}
+				}
+			}
+		}
+		return ret;
+	}
+
+	const auto cuckooTable = loadCuckooTable();
+
+	std::optional<ReversibleMove> findReversibleMove(std::uint64_t hashDifference) {
+		for (auto index : { CuckooTable::hash1(hashDifference), CuckooTable::hash2(hashDifference) }) {
+			if (cuckooTable.keys[index] == hashDifference) {
+				return cuckooTable.moves[index];
+			}
+		}
+		return std::nullopt;
+	}
+
 	std::uint64_t getStartingZobristHash(const Position& pos) {
 		std::uint64_t hash = 0;
 
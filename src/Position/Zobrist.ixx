@@ -2,6 +2,7 @@ export module Chess.Position:Zobrist;
 
 export import std;
 
+export import Chess.Bitboard;
 export import Chess.PieceType;
 export import Chess.Square;
 export import Chess.SafeInt;
@@ -14,4 +15,14 @@ export namespace chess {
 	std::uint64_t getZobristDoubleJumpSquareCode(Square doubleJumpedPawnSquare);
 	std::uint64_t getZobristTurnCode(bool isWhite);
 	std::uint64_t getStartingZobristHash(const Position& pos);
+
+	//a non-pawn move, which can always be played back
+	struct ReversibleMove {
+		Square from = Square::None;
+		Square to = Square::None;
+		Bitboard between = 0; //has to be empty for either side of the move to be playable
+		bool isWhite = true;
+	};
+	//the reversible move that changes a hash by hashDifference, found in O(1) in a cuckoo table
+	std::optional<ReversibleMove> findReversibleMove(std::uint64_t hashDifference);
 }
\ No newline at end of file
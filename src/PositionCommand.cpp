@@ -3,39 +3,44 @@ module Chess.PositionCommand;
 import Chess.Assert;
 
 namespace chess {
-	PositionCommand parsePositionCommand(const std::string& fenStr) {
-		PositionCommand ret;
+	std::string_view trim(std::string_view str) {
+		auto begin = std::ranges::find_if_not(str, isCommandWhitespace);
+		auto end = std::ranges::find_if_not(str | std::views::reverse, isCommandWhitespace).base();
+		return begin < end ? std::string_view{ begin, end } : std::string_view{};
+	}
 
-		std::istringstream iss{ fenStr };
+	PositionCommand parsePositionCommand(std::string_view fenStr) {
+		PositionCommand ret;
 
-		std::string token;
-		iss >> token;
+		auto remaining = fenStr;
+		auto token = nextToken(remaining);
 
 		//"position" token should already have been consumed in UCI command parser 
 		zAssert(token != "position");
 
-		auto getFENTokens = [&ret](std::istringstream& iss) {
-			iss >> ret.board;
-			iss >> ret.color;
-			iss >> ret.castlingPrivileges;
-			iss >> ret.enPessantSquare;
+		auto getFENTokens = [&ret](std::string_view fen) {
+			ret.board = nextToken(fen);
+			auto color = nextToken(fen);
+			ret.color = color.empty() ? 'w' : color.front();
+			ret.castlingPrivileges = nextToken(fen);
+			ret.enPessantSquare = nextToken(fen);
+			if (auto halfmoveClock = nextToken(fen); halfmoveClock != "moves") {
+				ret.halfmoveClock = halfmoveClock;
+			}
 		};
 		
 		if (token == "startpos") {
-			std::istringstream newIss{ std::string{ STARTING_FEN_STRING.data(), STARTING_FEN_STRING.size() } };
-			getFENTokens(newIss);
+			getFENTokens(STARTING_FEN_STRING);
 		} else {
 			zAssert(token == "fen");
-			getFENTokens(iss);
+			getFENTokens(remaining);
 		}
 
-		//skip halfmove clock and fullmove number
-		while (iss >> token && token != "moves");
-
-		if (token == "moves") {
-			while (iss >> token) {
-				ret.moves.push_back(token);
-			}
+		//skip fullmove number
+		auto movesIndex = remaining.find("moves");
+		ret.setup = trim(fenStr.substr(0, movesIndex == std::string_view::npos ? fenStr.size() : static_cast<size_t>(remaining.data() - fenStr.data()) + movesIndex));
+		if (movesIndex != std::string_view::npos) {
+			ret.moves = trim(remaining.substr(movesIndex + std::string_view{ "moves" }.size()));
 		}
 
 		return ret; 
@@ -5,13 +5,41 @@ import std;
 export namespace chess {
 	constexpr std::string_view STARTING_FEN_STRING = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
 
+	constexpr bool isCommandWhitespace(char c) {
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+
+	//removes and returns the next whitespace separated token, or an empty view once str is exhausted
+	constexpr std::string_view nextToken(std::string_view& str) {
+		auto begin = std::ranges::find_if_not(str, isCommandWhitespace);
+		auto end = std::ranges::find_if(begin, str.end(), isCommandWhitespace);
+		std::string_view ret{ begin, end };
+		str = std::string_view{ end, str.end() };
+		return ret;
+	}
+
+	//splits moves in UCI notation without allocating, on the same whitespace as nextToken
+	constexpr auto splitMoves(std::string_view moves) {
+		return moves
+			| std::views::chunk_by([](char a, char b) { return isCommandWhitespace(a) == isCommandWhitespace(b); })
+			| std::views::transform([](auto&& rng) { return std::string_view(rng.data(), rng.size()); })
+			| std::views::filter([](std::string_view token) { return !isCommandWhitespace(token.front()); });
+	}
+
+	//views into the parsed command string (or STARTING_FEN_STRING), which has to outlive the command
 	struct PositionCommand {
-		std::string board;
+		std::string_view board;
 		char color = 'w';
-		std::string castlingPrivileges;
-		std::string enPessantSquare;
-		std::vector<std::string> moves;
+		std::string_view castlingPrivileges;
+		std::string_view enPessantSquare;
+		std::string_view halfmoveClock; //empty when the FEN leaves it out
+		std::string_view setup; //everything before "moves", so that a command continuing the last game can be detected
+		std::string_view moves; //the moves in UCI notation, separated by whitespace
+
+		auto getMoves() const {
+			return splitMoves(moves);
+		}
 	};
 
-	PositionCommand parsePositionCommand(const std::string& uciCommandStr);
-}
\ No newline at end of file
+	PositionCommand parsePositionCommand(std::string_view uciCommandStr);
+}
@@ -0,0 +1,254 @@
+module;
+
+#ifdef _WIN64
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+module Chess.SearchTrace;
+
+import nlohmann.json;
+
+import Chess.EnvironmentVariable;
+
+namespace chess {
+	void* mapFile(const std::filesystem::path& path, size_t size) {
+#ifdef _WIN64
+		auto file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return nullptr;
+		}
+		auto sizeHigh = static_cast<DWORD>(static_cast<std::uint64_t>(size) >> 32);
+		auto sizeLow = static_cast<DWORD>(size & 0xFFFFFFFF);
+		auto mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, sizeHigh, sizeLow, nullptr);
+		CloseHandle(file); //the mapping keeps the file open
+		if (!mapping) {
+			return nullptr;
+		}
+		auto view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+		CloseHandle(mapping); //the view keeps the mapping alive
+		return view;
+#else
+		auto file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (file < 0) {
+			return nullptr;
+		}
+		if (ftruncate(file, static_cast<off_t>(size)) != 0) {
+			::close(file);
+			return nullptr;
+		}
+		auto view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+		::close(file);
+		return view == MAP_FAILED ? nullptr : view;
+#endif
+	}
+
+	void unmapFile(void* view, size_t size) {
+#ifdef _WIN64
+		(void)size;
+		UnmapViewOfFile(view);
+#else
+		munmap(view, size);
+#endif
+	}
+
+	SearchTraceRecorder::SearchTraceRecorder(SearchTraceRecorder&& other) noexcept {
+		*this = std::move(other);
+	}
+
+	SearchTraceRecorder& SearchTraceRecorder::operator=(SearchTraceRecorder&& other) noexcept {
+		if (this != &other) {
+			close();
+			m_view = std::exchange(other.m_view, nullptr);
+			m_viewSize = std::exchange(other.m_viewSize, 0);
+			m_header = std::exchange(other.m_header, nullptr);
+			m_records = std::exchange(other.m_records, nullptr);
+		}
+		return *this;
+	}
+
+	SearchTraceRecorder::~SearchTraceRecorder() {
+		close();
+	}
+
+	void SearchTraceRecorder::close() {
+		if (m_view) {
+			unmapFile(m_view, m_viewSize);
+		}
+		m_view = nullptr;
+		m_viewSize = 0;
+		m_header = nullptr;
+		m_records = nullptr;
+	}
+
+	bool SearchTraceRecorder::open(const std::filesystem::path& path, std::uint32_t capacity) {
+		close();
+		std::error_code ec;
+		std::filesystem::create_directories(path.parent_path(), ec);
+
+		auto size = sizeof(TraceFileHeader) + static_cast<size_t>(capacity) * sizeof(TraceRecord);
+		m_view = mapFile(path, size);
+		if (!m_view) {
+			std::println("Error: could not map search trace file {}", path.string());
+			return false;
+		}
+		m_viewSize = size;
+		m_header = new (m_view) TraceFileHeader{ .capacity = capacity };
+		m_records = reinterpret_cast<TraceRecord*>(static_cast<std::byte*>(m_view) + sizeof(TraceFileHeader));
+		return true;
+	}
+
+	std::filesystem::path getSearchTracePath(size_t threadIndex) {
+		return getAssetDirectoryPath() / "search_traces" / std::format("thread_{}.trace", threadIndex);
+	}
+
+	std::optional<std::vector<TraceRecord>> readSearchTrace(const std::filesystem::path& path) {
+		std::ifstream file{ path, std::ios::binary };
+		TraceFileHeader header;
+		if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != TRACE_MAGIC
+			|| header.version != TRACE_VERSION || header.recordSize != sizeof(TraceRecord) || header.capacity == 0)
+		{
+			std::println("Error: {} is not a search trace file", path.string());
+			return std::nullopt;
+		}
+
+		std::vector<TraceRecord> ring(std::min<std::uint64_t>(header.written, header.capacity));
+		file.read(reinterpret_cast<char*>(ring.data()), static_cast<std::streamsize>(ring.size() * sizeof(TraceRecord)));
+
+		//rotate so that the oldest record comes first
+		if (header.written > header.capacity) {
+			std::ranges::rotate(ring, ring.begin() + static_cast<std::ptrdiff_t>(header.written % header.capacity));
+		}
+		return ring;
+	}
+
+	struct PlyStats {
+		std::uint64_t nodes = 0;
+		std::uint64_t ttHits = 0;
+		std::uint64_t ttCutoffs = 0;
+		std::uint64_t cutoffs = 0;
+		std::uint64_t firstMoveCutoffs = 0;
+		std::uint64_t cutoffMoveIndexSum = 0;
+	};
+
+	void printSearchTraceStats(const std::filesystem::path& tracePath) {
+		auto records = readSearchTrace(tracePath);
+		if (!records) {
+			return;
+		}
+
+		std::vector<PlyStats> plies;
+		for (const auto& record : *records) {
+			if (record.ply >= plies.size()) {
+				plies.resize(record.ply + 1uz);
+			}
+			auto& stats = plies[record.ply];
+			stats.nodes++;
+			stats.ttHits += (record.flags & TraceRecord::TT_HIT) != 0;
+			stats.ttCutoffs += (record.flags & TraceRecord::TT_CUTOFF) != 0;
+			if (record.cutoffMoveIndex != NO_CUTOFF) {
+				stats.cutoffs++;
+				stats.firstMoveCutoffs += record.cutoffMoveIndex == 0;
+				stats.cutoffMoveIndexSum += record.cutoffMoveIndex;
+			}
+		}
+
+		auto percent = [](std::uint64_t part, std::uint64_t total) {
+			return total == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(total);
+		};
+		std::println("{} nodes", records->size());
+		std::println("{:>4} {:>12} {:>8} {:>8} {:>9} {:>10} {:>12} {:>8}", "ply", "nodes", "branch", "tt hit%", "tt cut%", "cutoff%", "first cut%", "avg cut");
+		for (auto ply = 0uz; ply < plies.size(); ply++) {
+			const auto& stats = plies[ply];
+			auto branching = ply == 0 || plies[ply - 1].nodes == 0 ? 0.0 : static_cast<double>(stats.nodes) / static_cast<double>(plies[ply - 1].nodes);
+			auto averageCutoffIndex = stats.cutoffs == 0 ? 0.0 : static_cast<double>(stats.cutoffMoveIndexSum) / static_cast<double>(stats.cutoffs);
+			std::println("{:>4} {:>12} {:>8.2f} {:>8.1f} {:>9.1f} {:>10.1f} {:>12.1f} {:>8.2f}", ply, stats.nodes, branching,
+				percent(stats.ttHits, stats.nodes), percent(stats.ttCutoffs, stats.nodes), percent(stats.cutoffs, stats.nodes),
+				percent(stats.firstMoveCutoffs, stats.cutoffs), averageCutoffIndex);
+		}
+	}
+
+	struct TraceNode {
+		TraceRecord record;
+		std::vector<TraceNode> children;
+		std::uint64_t subtreeSize = 1;
+	};
+
+	//rebuilds the trees from post-order records; the first nodes of a wrapped ring may have lost their ancestors
+	std::vector<TraceNode> buildTraceTrees(std::span<const TraceRecord> records) {
+		std::vector<std::vector<TraceNode>> pendingChildren(256);
+		for (const auto& record : records) {
+			TraceNode node{ record };
+			if (record.ply + 1uz < pendingChildren.size()) {
+				node.children = std::exchange(pendingChildren[record.ply + 1uz], {});
+			}
+			for (const auto& child : node.children) {
+				node.subtreeSize += child.subtreeSize;
+			}
+			pendingChildren[record.ply].push_back(std::move(node));
+		}
+		return std::move(pendingChildren.front());
+	}
+
+	//same schema as the profiling sessions, so that the visualizer can show the tree as a call graph
+	void addTraceNodeJson(nlohmann::json& entries, const TraceNode& node, const std::string& name, int maxPly) {
+		constexpr std::array BOUND_NAMES{ "exact", "lower", "upper" };
+		const auto& record = node.record;
+
+		nlohmann::json entry;
+		entry["name"] = name;
+		entry["times_run"] = node.subtreeSize;
+		entry["average_ns"] = 0;
+		entry["ply"] = record.ply;
+		entry["remaining_depth"] = record.remainingDepth;
+		entry["alpha"] = record.alpha;
+		entry["beta"] = record.beta;
+		entry["result"] = record.result;
+		entry["bound"] = record.bound < BOUND_NAMES.size() ? BOUND_NAMES[record.bound] : "unknown";
+		entry["tt_hit"] = (record.flags & TraceRecord::TT_HIT) != 0;
+		entry["tt_cutoff"] = (record.flags & TraceRecord::TT_CUTOFF) != 0;
+		entry["cutoff_move_index"] = record.cutoffMoveIndex == NO_CUTOFF ? nlohmann::json{} : nlohmann::json(record.cutoffMoveIndex);
+
+		auto expand = record.ply < maxPly && !node.children.empty();
+		if (expand) {
+			nlohmann::json childPercentages;
+			for (const auto& child : node.children) {
+				childPercentages[name + " " + child.record.getMove().getLongAlgebraicString()] = 100.0 * static_cast<double>(child.subtreeSize) / static_cast<double>(node.subtreeSize);
+			}
+			entry["child_percentages"] = childPercentages;
+		} else {
+			entry["child_percentages"] = nullptr;
+		}
+		entries.push_back(entry);
+
+		if (expand) {
+			for (const auto& child : node.children) {
+				addTraceNodeJson(entries, child, name + " " + child.record.getMove().getLongAlgebraicString(), maxPly);
+			}
+		}
+	}
+
+	void writeSearchTraceJson(const std::filesystem::path& tracePath, const std::filesystem::path& outputPath, int maxPly) {
+		auto records = readSearchTrace(tracePath);
+		if (!records) {
+			return;
+		}
+		auto roots = buildTraceTrees(*records);
+		if (roots.empty()) {
+			std::println("Error: {} holds no complete search", tracePath.string());
+			return;
+		}
+
+		//the last root is the deepest iteration that finished
+		auto entries = nlohmann::json::array();
+		addTraceNodeJson(entries, roots.back(), "root", maxPly);
+
+		std::ofstream file{ outputPath };
+		file << entries.dump(2);
+		std::println("Wrote {} nodes to {}", entries.size(), outputPath.string());
+	}
+}
\ No newline at end of file
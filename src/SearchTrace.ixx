@@ -0,0 +1,95 @@
+export module Chess.SearchTrace;
+
+export import std;
+export import Chess.Move;
+export import Chess.Rating;
+
+export namespace chess {
+	//build with CHESS_SEARCH_TRACE defined to record every node the search visits; otherwise every call compiles away
+#ifdef CHESS_SEARCH_TRACE
+	constexpr bool SEARCH_TRACE_ENABLED = true;
+#else
+	constexpr bool SEARCH_TRACE_ENABLED = false;
+#endif
+
+	constexpr std::uint32_t TRACE_MAGIC = 0x52545341; //"ASTR"
+	constexpr std::uint32_t TRACE_VERSION = 1;
+	constexpr std::uint32_t TRACE_RING_CAPACITY = 1u << 20; //records per thread, 32MB per file
+
+	constexpr std::uint8_t NO_CUTOFF = 255;
+
+	//filled in while a node is searched, since the interesting parts are only known once its children return
+	struct TraceNodeInfo {
+		std::uint8_t bound = 0; //WindowBound of the result
+		std::uint8_t cutoffMoveIndex = NO_CUTOFF;
+		bool ttHit = false;
+		bool ttCutoff = false; //the node returned straight from the TT
+	};
+
+	//one finished node, written in post-order, so the children of a node come right before it
+	struct TraceRecord {
+		std::uint64_t hash = 0;
+		Rating alpha = 0_rt;
+		Rating beta = 0_rt;
+		Rating result = 0_rt;
+		Square from = Square::None; //the move that led to the node
+		Square to = Square::None;
+		Piece promotionPiece = Piece::None;
+		std::uint8_t ply = 0;
+		std::uint8_t remainingDepth = 0;
+		std::uint8_t bound = 0;
+		std::uint8_t cutoffMoveIndex = NO_CUTOFF;
+		std::uint8_t flags = 0;
+
+		static constexpr std::uint8_t TT_HIT = 1;
+		static constexpr std::uint8_t TT_CUTOFF = 2;
+
+		Move getMove() const {
+			return Move{ from, to, Piece::None, Piece::None, promotionPiece };
+		}
+	};
+	static_assert(sizeof(TraceRecord) == 32 && std::is_trivially_copyable_v<TraceRecord>);
+
+	struct TraceFileHeader {
+		std::uint32_t magic = TRACE_MAGIC;
+		std::uint32_t version = TRACE_VERSION;
+		std::uint32_t recordSize = sizeof(TraceRecord);
+		std::uint32_t capacity = 0;
+		std::uint64_t written = 0; //once it passes capacity, the oldest record is at written % capacity
+	};
+
+	//appends records to a memory mapped ring file owned by one thread
+	class SearchTraceRecorder {
+	private:
+		void* m_view = nullptr;
+		size_t m_viewSize = 0;
+		TraceFileHeader* m_header = nullptr;
+		TraceRecord* m_records = nullptr;
+
+		void close();
+	public:
+		SearchTraceRecorder() = default;
+		SearchTraceRecorder(SearchTraceRecorder&& other) noexcept;
+		SearchTraceRecorder& operator=(SearchTraceRecorder&& other) noexcept;
+		~SearchTraceRecorder();
+
+		bool open(const std::filesystem::path& path, std::uint32_t capacity = TRACE_RING_CAPACITY);
+
+		void record(const TraceRecord& record) {
+			if (!m_records) {
+				return;
+			}
+			m_records[m_header->written % m_header->capacity] = record;
+			m_header->written++;
+		}
+	};
+
+	std::filesystem::path getSearchTracePath(size_t threadIndex);
+
+	//the records of a trace file, oldest first
+	std::optional<std::vector<TraceRecord>> readSearchTrace(const std::filesystem::path& path);
+
+	//the conversion tool behind the trace_stats and trace_json commands
+	void printSearchTraceStats(const std::filesystem::path& tracePath);
+	void writeSearchTraceJson(const std::filesystem::path& tracePath, const std::filesystem::path& outputPath, int maxPly);
+}
\ No newline at end of file
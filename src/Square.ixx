@@ -148,10 +148,10 @@ export namespace chess {
             std::ranges::fill(m_entries, T{});
         }
         constexpr explicit SquareMap(const Buffer& buffer) : m_entries{ buffer } {}
-        decltype(auto) operator[](this auto&& self, Square square) {
+        constexpr decltype(auto) operator[](this auto&& self, Square square) {
             return std::forward_like<decltype(self)>(self.m_entries[static_cast<size_t>(square)]);
         }
-        auto& get(this auto&& self) {
+        constexpr auto& get(this auto&& self) {
             return std::forward_like<decltype(self)>(self.m_entries);
         }
     };
@@ -27,8 +27,8 @@ namespace chess {
 		return ret;
 	}
 
-	Rating calcPieceDevelopmentRating(const Position& pos, const PositionData& posData) {
-		auto [whiteDestSquareMap, blackDestSquareMap] = calcDestinationSquareMap(pos, posData);
+	Rating calcPieceDevelopmentRating(const Position& pos, const PositionData&) {
+		auto [whiteDestSquareMap, blackDestSquareMap] = calcDestinationSquareMap(pos);
 		return calcPieceDevelopmentRatingImpl(whiteDestSquareMap) - calcPieceDevelopmentRatingImpl(blackDestSquareMap);
 	}
 }
\ No newline at end of file
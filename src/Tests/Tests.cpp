@@ -39,6 +39,7 @@ import Chess.MoveGeneration;
 import Chess.MoveSearch;
 import Chess.Position.RepetitionMap;
 import Chess.SafeInt;
+import Chess.SquareZone;
 
 import :Pipe;
 
@@ -59,8 +60,8 @@ namespace chess {
 			assert_equality(turnData.isWhite, true);
 
 			auto [white, black] = pos.getColorSides();
-			assert_equality(&turnData.allies, &white);
-			assert_equality(&turnData.enemies, &black);
+			assert_equality(turnData.allies.calcAllLocations(), white.calcAllLocations());
+			assert_equality(turnData.enemies.calcAllLocations(), black.calcAllLocations());
 
 			//test pawn locations
 			assert_equality(turnData.allies[Pawn], 0x000000000000FF00);
@@ -92,6 +93,29 @@ namespace chess {
 			assert_equality(turnData.enemies[Bishop], 0x2400000000000000);
 		}
 
+		void testPositionCommandParsing() {
+			using namespace std::literals;
+
+			auto command = parsePositionCommand("startpos moves e2e4  e7e5 g1f3\r");
+			assert_equality(command.setup, "startpos"sv);
+			assert_equality(command.moves, "e2e4  e7e5 g1f3"sv);
+			assert_equality(std::ranges::distance(command.getMoves()), 3);
+
+			auto fenCommand = parsePositionCommand("fen 4k3/8/8/8/8/8/8/4K3 b - - 0 1");
+			assert_equality(fenCommand.setup, "fen 4k3/8/8/8/8/8/8/4K3 b - - 0 1"sv);
+			assert_equality(fenCommand.color, 'b');
+			assert_equality(fenCommand.halfmoveClock, "0"sv);
+			assert_equality(fenCommand.moves.empty(), true);
+
+			auto shortFenCommand = parsePositionCommand("fen 4k3/8/8/8/8/8/8/4K3 b - - moves e8d8");
+			assert_equality(shortFenCommand.halfmoveClock.empty(), true);
+			assert_equality(std::ranges::distance(shortFenCommand.getMoves()), 1);
+
+			//moves are separated by the same whitespace as the other tokens
+			auto tabCommand = parsePositionCommand("startpos moves e2e4\te7e5\r\ng1f3");
+			assert_equality(std::ranges::equal(tabCommand.getMoves(), std::array{ "e2e4"sv, "e7e5"sv, "g1f3"sv }), true);
+		}
+
 		void testPawnLocations() {
 			Position pos;
 			auto [white, black] = pos.getColorSides();
@@ -201,6 +225,85 @@ namespace chess {
 			testMovesImpl("testCheck3", "fen 1b2n3/5N1p/1p1pBk1R/p1p1p3/P3P3/R2P4/1PP2P2/4K3 b - - 25 45", King, Square::E6);
 		}
 
+		void testCheckEvasions() {
+			auto getMoveStrings = [](std::string_view fen) {
+				Position pos;
+				pos.setPos(parsePositionCommand(fen));
+				auto moves = calcPositionData(pos).legalMoves | std::views::transform(&Move::getUCIString) | std::ranges::to<std::vector>();
+				std::ranges::sort(moves);
+				return moves;
+			};
+
+			//blocks by a knight, a bishop and a rook, besides the king moves
+			auto rookCheck = getMoveStrings("fen 4r1k1/8/8/R7/8/2N5/8/4KB2 w - - 0 1");
+			assert_equality(rookCheck == std::vector<std::string>({ "a5e5", "c3e2", "c3e4", "e1d1", "e1d2", "e1f2", "f1e2" }), true);
+
+			//single and double pawn pushes onto the check ray
+			auto bishopCheck = getMoveStrings("fen 4k3/8/8/b7/8/8/1PP5/4K3 w - - 0 1");
+			assert_equality(bishopCheck == std::vector<std::string>({ "b2b4", "c2c3", "e1d1", "e1e2", "e1f1", "e1f2" }), true);
+		}
+
+		void testSlidingAttackBackends() {
+			constexpr std::array FENS{
+				"fen r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R w KQ - 0 8",
+				"fen 8/5k2/3q4/8/2B5/4R3/1Q3K2/8 w - - 0 1",
+				"fen r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"
+			};
+			auto selected = getSlidingAttackBackend();
+			for (auto fen : FENS) {
+				Position pos;
+				pos.setPos(parsePositionCommand(fen));
+
+				auto getMoveStrings = [&](SlidingAttackBackend backend) {
+					setSlidingAttackBackend(backend);
+					auto moves = calcPositionData(pos).legalMoves | std::views::transform(&Move::getUCIString) | std::ranges::to<std::vector>();
+					std::ranges::sort(moves);
+					return moves;
+				};
+				auto fallbackMoves = getMoveStrings(SlidingAttackBackend::Fallback);
+				assert_equality(getMoveStrings(SlidingAttackBackend::Magic) == fallbackMoves, true);
+				if (isBmi2Supported()) { //pext is an illegal instruction without bmi2
+					assert_equality(getMoveStrings(SlidingAttackBackend::Pext) == fallbackMoves, true);
+					assert_equality(getMoveStrings(SlidingAttackBackend::CompressedPext) == fallbackMoves, true);
+				}
+			}
+			setSlidingAttackBackend(selected);
+		}
+
+		void testKoggeStoneSliders() {
+			if (!isAvx2Supported()) {
+				return;
+			}
+			constexpr std::array FENS{
+				"fen r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R w KQ - 0 8",
+				"fen 8/5k2/3q4/8/2B5/4R3/1Q3K2/8 w - - 0 1",
+				"fen Q6R/8/5k2/3b4/8/4K3/8/b6r w - - 0 1"
+			};
+			for (auto fen : FENS) {
+				Position pos;
+				pos.setPos(parsePositionCommand(fen));
+				auto [white, black] = pos.getColorSides();
+				auto empty = ~(white.calcAllLocations() | black.calcAllLocations());
+				for (const auto& side : { white, black }) {
+					auto rooksAndQueens = side[Rook] | side[Queen];
+					auto bishopsAndQueens = side[Bishop] | side[Queen];
+					assert_equality(calcKoggeStoneSlidingAttacks(rooksAndQueens, bishopsAndQueens, empty), calcTableSlidingAttacks(rooksAndQueens, bishopsAndQueens, empty));
+				}
+			}
+		}
+
+		void testLeaperTables() {
+			assert_equality(KNIGHT_ATTACKS[Square::A1], makeBitboard(Square::B3, Square::C2));
+			assert_equality(KING_ATTACKS[Square::H8], makeBitboard(Square::G8, Square::G7, Square::H7));
+			for (auto square : SQUARE_ARRAY) {
+				auto board = makeBitboard(square);
+				assert_equality(KNIGHT_ATTACKS[square], knightMoveGenerator(board, ALL_SQUARES).all());
+				assert_equality(KING_ATTACKS[square], calcSquareZone(board));
+			}
+			auto knights = makeBitboard(Square::B1, Square::G1, Square::D4);
+			assert_equality(knightTableGenerator(knights, ALL_SQUARES).all(), knightMoveGenerator(knights, ALL_SQUARES).all());
+		}
+
 		void testThatLegalMovesExist() {
 			constexpr auto POSITION_COMMAND = "fen r4b1r/p1p1p1pp/8/2Pp4/PP1PPBk1/6Q1/8/5RK1 b - - 1 31";
 			Position pos;
@@ -334,6 +437,21 @@ namespace chess {
 			testMovesImpl("testPin3", "fen rn2kb1r/4pppp/2p5/p4n2/P2q1PbP/1Pp2N2/3N2P1/R1BKQB1R w kq - 0 15", Knight, Square::C4);
 		}
 
+		void testPin4() {
+			Position pos;
+			pos.setPos(parsePositionCommand("fen 4k3/8/8/8/4r3/8/4R3/4K3 w - - 0 1"));
+
+			//the pinned rook can only slide towards its pinner or take it
+			auto legalMoveData = calcPositionData(pos);
+			auto rookMoves = legalMoveData.legalMoves | std::views::filter([](const Move& move) {
+				return move.from == Square::E2;
+			}) | std::ranges::to<std::vector>();
+			assert_equality(rookMoves.size(), 2uz);
+			for (const auto& move : rookMoves) {
+				assert_equality(move.to == Square::E3 || move.to == Square::E4, true);
+			}
+		}
+
 		void testPinWithCheck() {
 			Position pos;
 			pos.setPos(parsePositionCommand("fen 8/8/1r2knR1/2b5/1p2pBBP/1P1p4/5PP1/6K1 b - - 4 44"));
@@ -400,6 +518,78 @@ namespace chess {
 			std::println("{}", pipe.read("bestmove"));
 		}
 
+		void testStopLatency() {
+			using namespace std::literals;
+
+			Pipe pipe;
+			doUCIHandshake(pipe);
+
+			constexpr auto SAMPLE_COUNT = 10;
+			for (int i = 0; i < SAMPLE_COUNT; i++) {
+				pipe.write("ucinewgame\nposition startpos moves e2e4 e7e5 g1f3\ngo\n");
+				std::this_thread::sleep_for(100ms);
+
+				auto stopTime = std::chrono::steady_clock::now();
+				pipe.write("stop\n");
+				auto bestMove = pipe.read("bestmove");
+				auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - stopTime);
+
+				std::println("{} after {}", bestMove, latency);
+				if (latency > 1ms) {
+					std::println("testStopLatency failed: stop took longer than 1ms");
+				}
+			}
+		}
+
+		void testPonderHit() {
+			using namespace std::literals;
+
+			Pipe pipe;
+			pipe.write("setoption name Ponder value true\n");
+			doUCIHandshake(pipe);
+
+			pipe.write("position startpos moves e2e4\ngo wtime 10000 btime 10000\n");
+			auto bestMove = pipe.read("bestmove");
+			std::println("{}", bestMove);
+			if (!bestMove.contains(" ponder ")) {
+				std::println("testPonderHit failed: bestmove has no ponder move");
+				return;
+			}
+
+			//search the predicted reply for a while before telling the engine the guess was right
+			auto moves = bestMove.substr("bestmove "sv.size());
+			moves.replace(moves.find(" ponder "), " ponder "sv.size(), " ");
+			pipe.write(std::format("position startpos moves e2e4 {}\ngo ponder wtime 10000 btime 10000\n", moves));
+			std::this_thread::sleep_for(500ms);
+
+			auto ponderHitTime = std::chrono::steady_clock::now();
+			pipe.write("ponderhit\n");
+			std::println("{}", pipe.read("bestmove"));
+
+			auto thinkingTime = std::chrono::steady_clock::now() - ponderHitTime;
+			if (thinkingTime > 2s) { //the hard limit with 10s on the clock is well below this
+				std::println("testPonderHit failed: search took {} after ponderhit", std::chrono::duration_cast<std::chrono::milliseconds>(thinkingTime));
+			}
+		}
+
+		//a ponderhit that arrives before the search thread picks up the go has to start a timed search
+		void testEarlyPonderHit() {
+			using namespace std::literals;
+
+			Pipe pipe;
+			pipe.write("setoption name Ponder value true\n");
+			doUCIHandshake(pipe);
+
+			auto ponderHitTime = std::chrono::steady_clock::now();
+			pipe.write("position startpos moves e2e4 e7e5\ngo ponder wtime 10000 btime 10000\nponderhit\n");
+			std::println("{}", pipe.read("bestmove"));
+
+			auto thinkingTime = std::chrono::steady_clock::now() - ponderHitTime;
+			if (thinkingTime > 2s) {
+				std::println("testEarlyPonderHit failed: search took {} after ponderhit", std::chrono::duration_cast<std::chrono::milliseconds>(thinkingTime));
+			}
+		}
+
 		void testEnemySquareOutput() {
 			Position pos;
 			pos.setPos(parsePositionCommand("fen rnb1kbnr/pp1pppp1/2p5/q6p/2PPP3/8/PP1B1PPP/RN1QKBNR b KQkq - 1 1"));
@@ -416,10 +606,102 @@ namespace chess {
 			}
 		}
 
+		void testLazyEnemySquares() {
+			constexpr std::array FENS{
+				"fen rnb1kbnr/pp1pppp1/2p5/q6p/2PPP3/8/PP1B1PPP/RN1QKBNR b KQkq - 1 1",
+				"fen 8/8/1r2knR1/2b5/1p2pBBP/1P1p4/5PP1/6K1 b - - 4 44",
+				"fen r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+			};
+			for (auto fen : FENS) {
+				Position pos;
+				pos.setPos(parsePositionCommand(fen));
+
+				auto full = calcPositionData(pos);
+				auto lean = calcLegalMoves(pos);
+				assert_equality(lean.enemySquaresCalculated, false);
+				assert_equality(std::ranges::equal(lean.legalMoves, full.legalMoves), true);
+				assert_equality(lean.isCheck, full.isCheck);
+
+				calcEnemySquares(pos, lean);
+				assert_equality(lean.whiteSquares.destSquaresPinConsidered, full.whiteSquares.destSquaresPinConsidered);
+				assert_equality(lean.blackSquares.destSquaresPinConsidered, full.blackSquares.destSquaresPinConsidered);
+				assert_equality(lean.whiteSquares.allDestSquares, full.whiteSquares.allDestSquares);
+				assert_equality(lean.blackSquares.allDestSquares, full.blackSquares.allDestSquares);
+			}
+		}
+
 		void testCastling() {
 			testMovesImpl<false>("testCastling", "fen 3k4/3r4/8/8/8/8/4PPPP/4K2R w K - 0 1", King, Square::G1);
 		}
 
+		void testMakeUnmake() {
+			auto assertSamePosition = [](const Position& pos, const Position& expected) {
+				assert_equality(pos.hash(), expected.hash());
+				assert_equality(pos.isWhite(), expected.isWhite());
+				assert_equality(pos.getHalfmoveClock(), expected.getHalfmoveClock());
+				auto [white, black] = pos.getColorSides();
+				auto [expectedWhite, expectedBlack] = expected.getColorSides();
+				for (auto piece : ALL_PIECE_TYPES) {
+					assert_equality(white[piece], expectedWhite[piece]);
+					assert_equality(black[piece], expectedBlack[piece]);
+				}
+				assert_equality(white.castling.get(), expectedWhite.castling.get());
+				assert_equality(black.castling.get(), expectedBlack.castling.get());
+				assert_equality(white.doubleJumpedPawn, expectedWhite.doubleJumpedPawn);
+				assert_equality(black.doubleJumpedPawn, expectedBlack.doubleJumpedPawn);
+			};
+			//the shared mailbox and the occupancy have to agree with the piece bitboards on every square
+			auto assertMailboxMatches = [](const Position& pos) {
+				auto [white, black] = pos.getColorSides();
+				assert_equality(white.calcAllLocations() & black.calcAllLocations(), 0_bb);
+				for (const auto& side : { white, black }) {
+					auto allPieces = 0_bb;
+					for (auto piece : ALL_PIECE_TYPES) {
+						allPieces |= side[piece];
+					}
+					assert_equality(side.calcAllLocations(), allPieces);
+					for (auto square = 0; square < 64; square++) {
+						auto bitboardPiece = Piece::None;
+						for (auto piece : ALL_PIECE_TYPES) {
+							if (side[piece] & makeBitboard(static_cast<Square>(square))) {
+								bitboardPiece = piece;
+							}
+						}
+						assert_equality(side.findPiece(static_cast<Square>(square)), bitboardPiece);
+					}
+				}
+			};
+
+			//castling both ways, en passant, promotions with and without captures, and rook captures that remove castling rights
+			constexpr std::array FENS{
+				"fen r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+				"fen r3k2r/p1ppqpb1/bn2pnp1/3PN3/Pp2P3/2N2Q1p/1PPBBPPP/R3K2R b KQkq a3 0 1",
+				"fen n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+			};
+			for (auto fen : FENS) {
+				Position pos;
+				pos.setPos(parsePositionCommand(fen));
+				auto original = pos;
+
+				auto positionData = calcPositionData(pos);
+				for (const auto& move : positionData.legalMoves) {
+					assert_equality(move.kind, move.calcKind()); //the generator's tag picks the make path
+					auto undo = pos.move(move);
+					assertMailboxMatches(pos);
+					auto replyData = calcPositionData(pos);
+					for (const auto& reply : replyData.legalMoves) {
+						auto beforeReply = pos;
+						auto replyUndo = pos.move(reply);
+						pos.unmake(reply, replyUndo);
+						assertSamePosition(pos, beforeReply);
+					}
+					pos.unmake(move, undo);
+					assertSamePosition(pos, original);
+					assertMailboxMatches(pos);
+				}
+			}
+		}
+
 		void testRepetition() {
 			RepetitionMap rMap;
 			Position startPos;
@@ -449,12 +731,43 @@ namespace chess {
 			Position p4{ p3, blackBack };
 			rMap.push(p4);
 			assert_equality(rMap.getPositionCount(p4), 2);
+			assert_equality(p4.getHalfmoveClock(), 4);
+
+			//a pawn move is irreversible, so nothing before it is scanned
+			Position p5{ p4, Move{ Square::E2, Square::E4, Pawn, Piece::None } };
+			rMap.push(p5);
+			assert_equality(p5.getHalfmoveClock(), 0);
+			assert_equality(rMap.getPositionCount(p5), 1);
 
 			if (p4.hash() != startPos.hash()) {
 				std::println("testRepetitionFailed: p4 is not equal to startPos");
 			}
 		}
 
+		void testUpcomingRepetition() {
+			RepetitionMap rMap;
+			Position pos;
+			pos.setPos(parsePositionCommand("startpos"));
+			auto startHash = pos.hash();
+			rMap.push(pos);
+
+			for (auto move : { "g1f3", "g8f6", "f3g1" }) {
+				pos.move(move);
+				rMap.push(pos);
+			}
+
+			//black can play f6g8 to get back to the starting position
+			assert_equality(pos.findReversibleMoveColor(startHash).value_or(true), false);
+			assert_equality(rMap.hasUpcomingRepetition(pos, 4), true);
+
+			//at the root, the starting position would only come back a second time
+			assert_equality(rMap.hasUpcomingRepetition(pos, 0), false);
+
+			pos.move("e7e5");
+			rMap.push(pos);
+			assert_equality(rMap.hasUpcomingRepetition(pos, 5), false);
+		}
+
 		void testRepetition2() {
 			RepetitionMap rMap;
 			Position pos;
@@ -478,12 +791,127 @@ namespace chess {
 			assert_equality(bestMove->to, Square::G2);
 		}
 
+		void testDeterministicSearch() {
+			Position pos;
+			pos.setPos(parsePositionCommand("fen r1bqkbnr/pppp1ppp/2n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R b KQkq - 3 3"));
+			RepetitionMap rMap;
+			rMap.push(pos);
+
+			auto& search = getSearchFunction();
+			search.setOptions(SearchOptions{ .threadCount = 1uz, .seed = 0 });
+
+			auto runSearch = [&] {
+				clearTranspositionTable();
+				auto bestMove = search.findBestMove(pos, SearchLimits{ .nodes = 20000 }, rMap);
+				return std::pair{ bestMove, search.getNodeCount() };
+			};
+			auto [firstMove, firstNodes] = runSearch();
+			auto [secondMove, secondNodes] = runSearch();
+
+			assert_equality(firstMove.has_value(), true);
+			assert_equality(firstMove == secondMove, true);
+			assert_equality(firstNodes, secondNodes);
+
+			search.setOptions(SearchOptions{});
+		}
+
+		void testSearchInfo() {
+			Position pos;
+			pos.setPos(parsePositionCommand("fen r1bqkbnr/pppp1ppp/2n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R b KQkq - 3 3"));
+			RepetitionMap rMap;
+			rMap.push(pos);
+
+			clearTranspositionTable(); //a deeper stored root would skip the early iterations
+			std::vector<SearchInfo> infos;
+			auto& search = getSearchFunction();
+			search.setOptions(SearchOptions{ .threadCount = 1uz });
+			search.setReporter(SearchReporter{
+				.onIterationCompleted = [&](const SearchInfo& info) { infos.push_back(info); }
+			});
+			auto bestMove = search.findBestMove(pos, 4_su8, rMap);
+
+			assert_equality(infos.size(), 4uz);
+			for (const auto& [i, info] : std::views::enumerate(infos)) {
+				assert_equality(info.depth, static_cast<int>(i) + 1);
+				assert_equality(info.selectiveDepth >= info.depth, true);
+				assert_equality(info.pv.empty(), false);
+			}
+			if (!infos.empty() && !infos.back().pv.empty()) {
+				assert_equality(infos.back().pv.front() == bestMove, true); //a single searcher has nobody to be outvoted by
+			}
+
+			search.setReporter({});
+			search.setOptions(SearchOptions{});
+		}
+
+		void testMultiPV() {
+			Position pos;
+			pos.setPos(parsePositionCommand("fen r1bqkbnr/pppp1ppp/2n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R b KQkq - 3 3"));
+			RepetitionMap rMap;
+			rMap.push(pos);
+
+			constexpr auto LINE_COUNT = 3uz;
+			std::vector<SearchInfo> infos;
+			auto& search = getSearchFunction();
+			search.setOptions(SearchOptions{ .threadCount = 1uz, .multiPV = LINE_COUNT });
+			search.setReporter(SearchReporter{
+				.onIterationCompleted = [&](const SearchInfo& info) { infos.push_back(info); }
+			});
+			search.findBestMove(pos, 3_su8, rMap);
+
+			assert_equality(infos.size(), 3 * LINE_COUNT);
+			for (auto lines : infos | std::views::chunk(LINE_COUNT)) {
+				for (const auto& [i, line] : std::views::enumerate(lines)) {
+					assert_equality(line.multiPV, static_cast<int>(i) + 1);
+					assert_equality(line.pv.empty(), false);
+				}
+				for (const auto& [better, worse] : lines | std::views::pairwise) {
+					assert_equality(better.score >= worse.score, true);
+					if (!better.pv.empty() && !worse.pv.empty()) {
+						assert_equality(better.pv.front() == worse.pv.front(), false);
+					}
+				}
+			}
+
+			search.setReporter({});
+			search.setOptions(SearchOptions{});
+		}
+
+		void testSearchStatistics() {
+			Position pos;
+			pos.setPos(parsePositionCommand("fen r1bqkbnr/pppp1ppp/2n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R b KQkq - 3 3"));
+			RepetitionMap rMap;
+			rMap.push(pos);
+
+			clearTranspositionTable();
+			auto& search = getSearchFunction();
+			search.setOptions(SearchOptions{ .threadCount = 1uz, .multiPV = 2 });
+			search.findBestMove(pos, 4_su8, rMap);
+			const auto& statistics = search.getStatistics();
+
+			assert_equality(statistics.nodesPerPly[0] >= 8, true); //both root passes of each iteration
+			assert_equality(statistics.nodesPerPly[4] > 0, true);
+			for (auto depth = 1uz; depth <= 4; depth++) {
+				assert_equality(statistics.iterationNodes[depth] > 0, true);
+			}
+			assert_equality(statistics.getBranchingFactor(4).has_value(), true);
+			assert_equality(statistics.firstMoveCutoffs <= statistics.cutoffs, true);
+			assert_equality(statistics.ttHits <= statistics.ttProbes, true);
+			assert_equality(statistics.ttUsable <= statistics.ttHits, true);
+			assert_equality(statistics.ttCollisions, 0ull);
+			assert_equality(statistics.killerCutoffs <= statistics.killerMovesSearched, true);
+			assert_equality(statistics.reSearches, 4ull); //one extra root pass per iteration for the second line
+
+			search.setOptions(SearchOptions{});
+		}
+
 		void runAllTests() {
 			std::println("Running tests...");
 
 			getSearchFunction(); //registers thread
 
 			testStartPos();
+			testPositionCommandParsing();
 			testPawnLocations();
 			testIllegalKingSquares();
 			testIndirectlyCheckedSquares();
@@ -493,6 +921,10 @@ namespace chess {
 			testCheck();
 			testCheck2();
 			testCheck3();
+			testCheckEvasions();
+			testSlidingAttackBackends();
+			testKoggeStoneSliders();
+			testLeaperTables();
 			testThatLegalMovesExist();
 			testThatLegalMovesExist2();
 			testThatLegalMovesExist3();
@@ -503,19 +935,30 @@ namespace chess {
 			testPin();
 			testPin2();
 			testPin3();
+			testPin4();
 			testEnPassantPin();
 			testPinWithCheck();
 			testPinWithCheck2();
 			testBitboardImageCreation();
 			testEnemySquareOutput();
+			testLazyEnemySquares();
 			testCastling();
+			testMakeUnmake();
 			runInternalEvaluationTests();
 			runInternalMoveSearchTests();
 			testRepetition();
 			testRepetition2();
+			testUpcomingRepetition();
 			testCheckmate();
+			testDeterministicSearch();
+			testSearchInfo();
+			testMultiPV();
+			testSearchStatistics();
 			std::println("Finished tests");
 			//testUCIInput(); //long!
+			//testStopLatency(); //long!
+			//testPonderHit(); //long!
+			//testEarlyPonderHit(); //long!
 		}
 	}
 }
\ No newline at end of file
@@ -1,44 +1,162 @@
 module Chess.Time;
 
 import std;
+import nlohmann.json;
 
 import Chess.Assert;
+import Chess.EnvironmentVariable;
 
 namespace chess {
 	using namespace std::literals;
 
+	//whole findBestMove times by depth and piece count, measured offline by measure_move_time; read only once loaded
 	class TimeMap {
 	private:
 		static constexpr auto MAX_DEPTH = 20;
 		static constexpr auto MAX_PIECE_COUNT = 32;
 
-		struct TimeData {
-			std::chrono::nanoseconds sum{ 0 };
-			int timesRan = 0;
+		using PieceTimeData = std::array<std::chrono::nanoseconds, MAX_PIECE_COUNT>;
+		std::array<PieceTimeData, MAX_DEPTH> m_data{};
 
-			std::chrono::nanoseconds getAverage() const {
-				return sum / timesRan;
-			}
-		};
-		using PieceTimeData = std::array<TimeData, MAX_PIECE_COUNT>;
-		std::array<PieceTimeData, MAX_DEPTH> m_data;
+		static bool inRange(int depth, int pieceCount) {
+			return depth > 0 && depth <= MAX_DEPTH && pieceCount >= 2 && pieceCount <= MAX_PIECE_COUNT;
+		}
 	public:
 		TimeMap() {
-			PieceTimeData defaultTimeData;
-			std::ranges::fill(defaultTimeData, TimeData{});
-			std::ranges::fill(m_data, defaultTimeData);
+			if (auto assetDirectory = findAssetDirectoryPath()) {
+				load(*assetDirectory / "depth_time.json");
+			}
 		}
 
-		std::chrono::nanoseconds getAverage(int depth, int pieceCount) const {
-			zAssert(depth > 0 && depth <= MAX_DEPTH);
-			zAssert(pieceCount >= 2 && pieceCount <= MAX_PIECE_COUNT);
-			return m_data[static_cast<size_t>(depth)][static_cast<size_t>(pieceCount)].getAverage();
+		//[depth - 1][pieceCount - 1], in nanoseconds; a missing or malformed file just leaves the map empty
+		void load(const std::filesystem::path& path) {
+			std::ifstream file{ path };
+			if (!file) {
+				return;
+			}
+			auto json = nlohmann::json::parse(file, nullptr, false);
+			if (json.is_discarded() || !json.is_array()) {
+				return;
+			}
+			for (auto depthIndex = 0uz; depthIndex < std::min(json.size(), m_data.size()); depthIndex++) {
+				const auto& averages = json[depthIndex];
+				if (!averages.is_array()) {
+					continue;
+				}
+				for (auto pieceIndex = 0uz; pieceIndex < std::min(averages.size(), m_data[depthIndex].size()); pieceIndex++) {
+					const auto& average = averages[pieceIndex];
+					if (average.is_number_integer()) {
+						m_data[depthIndex][pieceIndex] = std::chrono::nanoseconds{ average.get<std::chrono::nanoseconds::rep>() };
+					}
+				}
+			}
+		}
+
+		std::optional<std::chrono::nanoseconds> getAverage(int depth, int pieceCount) const {
+			if (!inRange(depth, pieceCount)) {
+				return std::nullopt;
+			}
+			auto average = m_data[static_cast<size_t>(depth - 1)][static_cast<size_t>(pieceCount - 1)];
+			return average > 0ns ? std::optional{ average } : std::nullopt;
 		}
 	};
-	TimeMap timeMap;
-	int baseDepth = 0;
 
-	void setBaseline(int depth) {
-		baseDepth = depth;
+	const TimeMap& getTimeMap() {
+		static const TimeMap timeMap;
+		return timeMap;
+	}
+
+	constexpr auto MOVE_OVERHEAD = 20ms; //GUI and pipe latency
+	constexpr auto MIN_THINKING_TIME = 1ms;
+	constexpr auto DEFAULT_MOVES_TO_GO = 30;
+	constexpr auto MAX_MOVES_TO_GO = 50;
+	constexpr auto DEFAULT_BRANCHING_FACTOR = 4.0;
+	constexpr auto MIN_BRANCHING_FACTOR = 1.5;
+	constexpr auto MAX_BRANCHING_FACTOR = 8.0;
+	constexpr auto MIN_MEASURABLE_ITERATION_TIME = 1ms; //shorter iterations are too noisy to extrapolate from
+	constexpr auto SMALL_SCORE_DROP = 0.25_rt;
+	constexpr auto LARGE_SCORE_DROP = 0.75_rt;
+	constexpr auto EASY_MOVE_STABLE_ITERATIONS = 3;
+	constexpr auto EASY_MOVE_MARGIN = 1.0_rt;
+	constexpr auto EASY_MOVE_TIME_DIVISOR = 3;
+
+	TimeManager::TimeManager(const Clock& clock, int pieceCount, TimePoint start)
+		: m_start{ start }, m_pieceCount{ pieceCount }
+	{
+		if (clock.moveTime) {
+			m_softLimit = std::max(*clock.moveTime - MOVE_OVERHEAD, MIN_THINKING_TIME);
+			m_hardLimit = m_softLimit;
+		} else {
+			std::chrono::nanoseconds available = std::max(clock.time - MOVE_OVERHEAD, MIN_THINKING_TIME);
+			auto movesToGo = std::clamp(clock.movesToGo.value_or(DEFAULT_MOVES_TO_GO), 1, MAX_MOVES_TO_GO);
+
+			std::chrono::nanoseconds soft = available / movesToGo + clock.increment * 3 / 4;
+			if (movesToGo > 1) {
+				soft = std::min(soft, available / 2); //never bet half the clock on one move
+			}
+			m_softLimit = std::min(soft, available);
+			m_hardLimit = std::clamp(m_softLimit * 4, m_softLimit, std::max(available * 4 / 5, m_softLimit));
+		}
+		m_extendedSoftLimit = m_softLimit;
+	}
+
+	TimeManager::TimePoint TimeManager::getHardDeadline() const {
+		return m_start + m_hardLimit;
+	}
+
+	std::chrono::nanoseconds TimeManager::getElapsedTime() const {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+	}
+
+	void TimeManager::onIterationCompleted(int depth, Rating score, std::chrono::nanoseconds iterationTime) {
+		m_previousIterationTime = m_lastIterationTime;
+		m_lastIterationTime = iterationTime;
+
+		//spend more time when the best line suddenly looks worse
+		if (m_lastScore) {
+			auto drop = *m_lastScore - score;
+			auto extended = m_extendedSoftLimit;
+			if (drop >= LARGE_SCORE_DROP) {
+				extended = m_softLimit * 2;
+			} else if (drop >= SMALL_SCORE_DROP) {
+				extended = m_softLimit * 3 / 2;
+			}
+			m_extendedSoftLimit = std::min(std::max(m_extendedSoftLimit, extended), m_hardLimit);
+		}
+		m_lastScore = score;
+	}
+
+	void TimeManager::onBestMoveStability(int stableIterations, Rating margin) {
+		//a score drop means the move isn't easy after all, whatever the margin
+		m_easyMove = stableIterations >= EASY_MOVE_STABLE_ITERATIONS && margin >= EASY_MOVE_MARGIN && m_extendedSoftLimit == m_softLimit;
+	}
+
+	double TimeManager::predictBranchingFactor(int nextDepth) const {
+		if (m_previousIterationTime >= MIN_MEASURABLE_ITERATION_TIME) {
+			auto measured = static_cast<double>(m_lastIterationTime.count()) / static_cast<double>(m_previousIterationTime.count());
+			return std::clamp(measured, MIN_BRANCHING_FACTOR, MAX_BRANCHING_FACTOR);
+		}
+
+		//the offline times are of whole searches rather than single iterations, so only their ratio is used
+		auto& timeMap = getTimeMap();
+		auto next = timeMap.getAverage(nextDepth, m_pieceCount);
+		auto last = timeMap.getAverage(nextDepth - 1, m_pieceCount);
+		if (next && last && last->count() > 0) {
+			auto predicted = static_cast<double>(next->count()) / static_cast<double>(last->count());
+			return std::clamp(predicted, MIN_BRANCHING_FACTOR, MAX_BRANCHING_FACTOR);
+		}
+		return DEFAULT_BRANCHING_FACTOR;
+	}
+
+	bool TimeManager::shouldStartNextIteration(int nextDepth) const {
+		auto elapsed = getElapsedTime();
+		auto softLimit = m_easyMove ? m_softLimit / EASY_MOVE_TIME_DIVISOR : m_extendedSoftLimit;
+		if (elapsed >= softLimit) {
+			return false;
+		}
+
+		//don't start an iteration that the hard limit would cut off anyway
+		auto predicted = std::chrono::duration_cast<std::chrono::nanoseconds>(m_lastIterationTime * predictBranchingFactor(nextDepth));
+		return elapsed + predicted <= m_hardLimit;
 	}
-}
\ No newline at end of file
+}
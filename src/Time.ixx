@@ -1,9 +1,42 @@
 export module Chess.Time;
 
 export import std;
+export import Chess.Rating;
 
 export namespace chess {
-	void setBaseline(int depth);
-	void setTime(int depth, int pieceCount, std::chrono::nanoseconds timeCalculated);
-	int getMaxDepth();
-}
\ No newline at end of file
+	struct Clock {
+		std::chrono::milliseconds time{ 0 };
+		std::chrono::milliseconds increment{ 0 };
+		std::optional<int> movesToGo = std::nullopt;
+		std::optional<std::chrono::milliseconds> moveTime = std::nullopt;
+	};
+
+	//allocates a soft limit (checked between iterations) and a hard limit (polled while searching) for one move
+	class TimeManager {
+	private:
+		using TimePoint = std::chrono::steady_clock::time_point;
+
+		TimePoint m_start;
+		std::chrono::nanoseconds m_softLimit{ 0 };
+		std::chrono::nanoseconds m_extendedSoftLimit{ 0 };
+		std::chrono::nanoseconds m_hardLimit{ 0 };
+		int m_pieceCount = 32;
+		std::chrono::nanoseconds m_lastIterationTime{ 0 };
+		std::chrono::nanoseconds m_previousIterationTime{ 0 };
+		std::optional<Rating> m_lastScore = std::nullopt;
+		bool m_easyMove = false;
+
+		double predictBranchingFactor(int nextDepth) const;
+	public:
+		TimeManager(const Clock& clock, int pieceCount, TimePoint start);
+
+		TimePoint getHardDeadline() const;
+		std::chrono::nanoseconds getElapsedTime() const;
+
+		//score is from the perspective of the side to move
+		void onIterationCompleted(int depth, Rating score, std::chrono::nanoseconds iterationTime);
+		//stableIterations in a row ended with the same best move, which beats the second best by margin
+		void onBestMoveStability(int stableIterations, Rating margin);
+		bool shouldStartNextIteration(int nextDepth) const;
+	};
+}
@@ -0,0 +1,42 @@
+module;
+
+#include <cstdio>
+
+module Chess.UCI:OutputWriter;
+
+namespace chess {
+	void OutputWriter::run(std::stop_token stopToken) {
+		std::vector<std::string> lines;
+		while (true) {
+			{
+				std::unique_lock l{ m_mutex };
+				m_cv.wait(l, stopToken, [this] {
+					return !m_lines.empty();
+				});
+				if (m_lines.empty()) { //only reached once stop was requested and everything was written
+					return;
+				}
+				std::swap(lines, m_lines);
+			}
+
+			for (const auto& line : lines) {
+				std::fwrite(line.data(), 1, line.size(), stdout);
+				std::fputc('\n', stdout);
+			}
+			std::fflush(stdout);
+			lines.clear();
+		}
+	}
+
+	OutputWriter::OutputWriter() {
+		m_thread = std::jthread{ [this](std::stop_token stopToken) { run(stopToken); } };
+	}
+
+	void OutputWriter::write(std::string line) {
+		{
+			std::scoped_lock l{ m_mutex };
+			m_lines.push_back(std::move(line));
+		}
+		m_cv.notify_one();
+	}
+}
@@ -0,0 +1,20 @@
+export module Chess.UCI:OutputWriter;
+
+export import std;
+
+namespace chess {
+	//the only thread that writes to stdout, so that searchers only ever pay for queueing a line
+	class OutputWriter {
+	private:
+		std::mutex m_mutex;
+		std::condition_variable_any m_cv;
+		std::vector<std::string> m_lines;
+		std::jthread m_thread; //thread is destroyed before all other members
+
+		void run(std::stop_token stopToken);
+	public:
+		OutputWriter();
+
+		void write(std::string line);
+	};
+}
@@ -1,18 +1,68 @@
-module;
-
-#include <cstdio>
-
 module Chess.UCI:SearchThread;
 
 import Chess.Assert;
 import Chess.DebugPrint;
+import Chess.GoCommand;
 import Chess.MoveSearch;
 import Chess.PositionCommand;
 import Chess.Position.RepetitionMap;
+import Chess.Time;
 
 using namespace std::literals;
 
 namespace chess {
+	std::string formatInfo(const SearchInfo& info) {
+		auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(info.time);
+		auto nps = info.time.count() > 0 ? info.nodes * 1'000'000'000 / static_cast<std::uint64_t>(info.time.count()) : 0;
+		auto score = info.mateIn ? std::format("mate {}", *info.mateIn) : std::format("cp {}", static_cast<int>(std::round(info.score * 100)));
+
+		auto ret = std::format("info depth {} seldepth {} multipv {} score {} nodes {} nps {} time {} pv",
+			info.depth, info.selectiveDepth, info.multiPV, score, info.nodes, nps, ms.count());
+		for (const auto& move : info.pv) {
+			ret += ' ';
+			ret += move.getLongAlgebraicString();
+		}
+		return ret;
+	}
+
+	std::string formatCurrentMove(const CurrentMoveInfo& info) {
+		return std::format("info depth {} currmove {} currmovenumber {}", info.depth, info.move.getLongAlgebraicString(), info.moveNumber);
+	}
+
+	SearchOptions EngineOptions::getSearchOptions() const {
+		if (deterministic) {
+			return { .threadCount = 1uz, .seed = seed, .multiPV = multiPV };
+		}
+		return { .threadCount = threads, .seed = seed == 0 ? std::nullopt : std::optional{ seed }, .multiPV = multiPV };
+	}
+
+	SearchLimits makeSearchLimits(const GameState& state) {
+		const auto& go = state.goCommand;
+		SearchLimits ret;
+		ret.nodes = go.nodes;
+		if (go.depth) {
+			ret.depth = SafeUnsigned{ static_cast<std::uint8_t>(std::clamp(*go.depth, 1, 255)) };
+		}
+		if (go.infinite) {
+			return ret;
+		}
+
+		auto isWhite = state.pos.isWhite();
+		auto time = isWhite ? go.whiteTime : go.blackTime;
+		if (go.moveTime || time) {
+			auto increment = isWhite ? go.whiteIncrement : go.blackIncrement;
+			ret.clock = Clock{
+				.time = time.value_or(0ms),
+				.increment = increment.value_or(0ms),
+				.movesToGo = go.movesToGo,
+				.moveTime = go.moveTime
+			};
+		} else if (!go.depth && !go.nodes) {
+			ret.depth = state.depth;
+		}
+		return ret;
+	}
+
 	void SearchThread::think(std::stop_token stopToken) {
 		while (!stopToken.stop_requested()) {
 			{
@@ -32,8 +82,11 @@ namespace chess {
 			}
 
 			auto stateCopy = m_state;
+			auto optionsCopy = m_options;
 			ul.unlock();
 
+			m_searcher.setOptions(optionsCopy.getSearchOptions());
+			m_searcher.setReporter({}); //pondering on our own guess is invisible to the GUI
 			auto move = m_searcher.findBestMove(stateCopy.pos, 255_su8, stateCopy.repetitionMap);
 			if (!move) { //if the position has no legal moves, then reset to an invalid position state
 				std::scoped_lock l{ m_mutex };
@@ -51,19 +104,47 @@ namespace chess {
 			think(stopToken);
 
 			GameState stateCopy;
+			EngineOptions optionsCopy;
+			auto ponder = false;
 			{
 				std::unique_lock l{ m_mutex };
 				stateCopy = m_state;
+				optionsCopy = m_options;
 				m_calculationRequested = false;
+				m_searching = true;
+				ponder = m_ponderSearch; //already cleared if the ponderhit came before we picked up the go
+				if (ponder) {
+					m_searcher.expectPonderSearch(); //ponderHit() forwards under this lock, so no hit slips in between
+				}
+			}
+
+			m_searcher.setOptions(optionsCopy.getSearchOptions());
+			m_searcher.setReporter(SearchReporter{
+				.onIterationCompleted = [this](const SearchInfo& info) { m_output.write(formatInfo(info)); },
+				.onCurrentMove = [this](const CurrentMoveInfo& info) { m_output.write(formatCurrentMove(info)); }
+			});
+			auto limits = makeSearchLimits(stateCopy);
+			limits.ponder = ponder;
+			auto bestMove = m_searcher.findBestMove(stateCopy.pos, limits, stateCopy.repetitionMap);
+			{
+				std::unique_lock l{ m_mutex };
+				m_searching = false;
+				m_cv.wait(l, stopToken, [this] { //UCI doesn't allow a bestmove while pondering, even if the search finished early
+					return !m_ponderSearch;
+				});
 			}
 
-			if (auto bestMove = m_searcher.findBestMove(stateCopy.pos, stateCopy.depth, stateCopy.repetitionMap)) {
+			if (bestMove) {
 				if (!stopToken.stop_requested()) {
-					std::println("{}", bestMove->getUCIString());
-					std::fflush(stdout);
-					m_state.pos.move(*bestMove);
+					auto bestMoveString = bestMove->getUCIString();
+					auto pv = m_searcher.getPrincipalVariation();
+					if (pv.size() >= 2 && pv.front() == *bestMove) {
+						bestMoveString += " ponder " + pv[1].getLongAlgebraicString();
+					}
+					m_output.write(std::move(bestMoveString));
 					std::scoped_lock l{ m_mutex };
-					m_shouldPonder = true;
+					m_state.pos.move(*bestMove);
+					m_shouldPonder = m_options.canPonderOnOwnGuess();
 				}
 			} else { //GUI sent us a position with zero legal moves
 				std::scoped_lock l{ m_mutex };
@@ -72,8 +153,8 @@ namespace chess {
 		}
 	}
 
-	SearchThread::SearchThread()
-		: m_searcher{}
+	SearchThread::SearchThread(OutputWriter& output)
+		: m_output{ output }, m_searcher{}
 	{
 		m_thread = std::jthread{ [this](std::stop_token stopToken){ run(stopToken); } };
 	}
@@ -84,18 +165,19 @@ namespace chess {
 	void SearchThread::setPosition(GameState state) {
 		{
 			std::scoped_lock l{ m_mutex };
-			m_shouldPonder = true;
+			m_shouldPonder = m_options.canPonderOnOwnGuess();
 			m_state = std::move(state);
 		}
 		m_cv.notify_one();
 	}
 
-	void SearchThread::go(SafeUnsigned<std::uint8_t> depth) {
+	void SearchThread::go(GoCommand goCommand) {
 		{
 			std::scoped_lock l{ m_mutex };
 			m_calculationRequested = true;
 			m_shouldPonder = false;
-			m_state.depth = depth;
+			m_state.goCommand = std::move(goCommand);
+			m_ponderSearch = m_state.goCommand.ponder; //set before run() picks it up, so that an early ponderhit isn't dropped
 		}
 		m_searcher.cancel();
 		m_cv.notify_one();
@@ -106,6 +188,41 @@ namespace chess {
 		{
 			std::scoped_lock l{ m_mutex };
 			m_shouldPonder = false;
+			m_ponderSearch = false;
+		}
+		m_cv.notify_one();
+	}
+
+	void SearchThread::ponderHit() {
+		{
+			std::scoped_lock l{ m_mutex };
+			if (!m_ponderSearch) {
+				return;
+			}
+			m_ponderSearch = false;
+			if (m_searching) {
+				m_searcher.ponderHit(); //internally synchronized, and kept for the expected search if it hasn't started yet
+			}
+		}
+		m_cv.notify_one();
+	}
+
+	void SearchThread::newGame() {
+		stop();
+		std::scoped_lock l{ m_mutex };
+		if (m_options.deterministic) {
+			clearTranspositionTable(); //otherwise earlier games change how this one is searched
+		}
+	}
+
+	void SearchThread::setOptions(EngineOptions options) {
+		m_searcher.cancel(); //options are only applied between searches
+		{
+			std::scoped_lock l{ m_mutex };
+			m_options = options;
+			if (!m_options.canPonderOnOwnGuess()) {
+				m_shouldPonder = false;
+			}
 		}
 		m_cv.notify_one();
 	}
@@ -2,36 +2,61 @@ export module Chess.UCI:SearchThread;
 
 export import std;
 
+import Chess.GoCommand;
 import Chess.Position;
 import Chess.Position.RepetitionMap;
 import Chess.MoveSearch;
 import Chess.SafeInt;
 
+import :OutputWriter;
+
 namespace chess {
 	struct GameState {
 		Position pos;
-		SafeUnsigned<std::uint8_t> depth{ 6_su8 };
+		SafeUnsigned<std::uint8_t> depth{ 6_su8 }; //used when go gives neither a clock nor a depth/node limit
 		RepetitionMap repetitionMap;
+		GoCommand goCommand;
+	};
+
+	struct EngineOptions {
+		size_t threads = AsyncSearch::getMaxThreadCount();
+		std::uint64_t seed = 0; //0 seeds the helpers from std::random_device unless deterministic
+		size_t multiPV = 1;
+		bool deterministic = false; //a single searcher, a fixed seed and no background pondering so that runs can be replayed
+		bool ponder = false; //the GUI ponders with go ponder, so we don't ponder on our own guess
+
+		bool canPonderOnOwnGuess() const {
+			return !deterministic && !ponder;
+		}
+
+		SearchOptions getSearchOptions() const;
 	};
 
 	class SearchThread {
 	private:
 		std::mutex m_mutex;
+		OutputWriter& m_output;
 		AsyncSearch m_searcher;
 		GameState m_state;
+		EngineOptions m_options;
 		bool m_shouldPonder = false;
 		bool m_calculationRequested = false;
+		bool m_searching = false;
+		bool m_ponderSearch = false; //a go ponder search whose bestmove has to wait for ponderhit or stop
 		std::condition_variable_any m_cv;
 		std::jthread m_thread; //thread is destroyed before all other members
 
 		void think(std::stop_token stopToken);
 		void run(std::stop_token stopToken);
 	public:
-		SearchThread();
+		explicit SearchThread(OutputWriter& output);
 		~SearchThread();
 
 		void stop();
+		void ponderHit();
 		void setPosition(GameState gameState);
-		void go(SafeUnsigned<std::uint8_t> depth);
+		void go(GoCommand goCommand);
+		void newGame();
+		void setOptions(EngineOptions options);
 	};
 }
\ No newline at end of file
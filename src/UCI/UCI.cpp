@@ -1,6 +1,6 @@
 module;
 
-#include <cstdio>
+#include <boost/functional/hash.hpp>
 
 module Chess.UCI;
 
@@ -8,43 +8,127 @@ import std;
 
 import Chess.DebugPrint;
 import Chess.Evaluation;
+import Chess.GoCommand;
 import Chess.Position.RepetitionMap;
 import Chess.PositionCommand;
+import Chess.MoveSearch;
 
+import :OutputWriter;
 import :SearchThread;
 
 namespace chess {
-	std::string getTokensAfterPosition(std::istringstream& iss) {
-		auto buff = iss.str();
-		auto currentPos = static_cast<size_t>(iss.tellg());
-		return buff.substr(currentPos);
+	std::string getRemainingTokens(std::istringstream& iss) {
+		std::string ret;
+		std::getline(iss, ret); //tellg() fails once the command has no arguments left
+		return ret;
+	}
+
+	//hashes of the last position command's setup and moves instead of copies, since the line they were parsed from is reused
+	struct PositionHistory {
+		size_t setupHash = 0;
+		size_t moveCount = 0;
+		size_t movesHash = 0;
+	};
+
+	void addMoveHash(size_t& hash, std::string_view move) {
+		boost::hash_combine(hash, std::hash<std::string_view>{}(move));
 	}
 
-	GameState makeGameState(const std::string& commandStr, SafeUnsigned<std::uint8_t> depth) {
-		GameState ret;
-		
+	//GUIs resend the whole game with every position command, so only the moves added since the last one are played
+	void updateGameState(GameState& state, PositionHistory& history, std::string_view commandStr) {
 		auto command = parsePositionCommand(commandStr);
-		ret.pos.setPos(command);
-		ret.repetitionMap.push(ret.pos);
+		auto setupHash = std::hash<std::string_view>{}(command.setup);
 
-		for (const auto& move : command.moves) {
-			ret.pos.move(move);
-			ret.repetitionMap.push(ret.pos);
+		//hash as many moves as the last command had; if they match, the kept position is already after them
+		auto moves = command.getMoves();
+		auto it = moves.begin();
+		auto moveCount = 0uz;
+		auto movesHash = 0uz;
+		for (; it != moves.end() && moveCount < history.moveCount; ++it, ++moveCount) {
+			addMoveHash(movesHash, *it);
 		}
 
-		ret.depth = depth;
+		auto continuesGame = setupHash == history.setupHash && moveCount == history.moveCount && movesHash == history.movesHash;
+		if (!continuesGame) {
+			state.pos.setPos(command);
+			state.repetitionMap.clear();
+			state.repetitionMap.push(state.pos);
+			it = moves.begin();
+			moveCount = 0;
+			movesHash = 0;
+		}
 
-		return ret;
+		for (; it != moves.end(); ++it, ++moveCount) {
+			state.pos.move(*it);
+			state.repetitionMap.push(state.pos);
+			addMoveHash(movesHash, *it);
+		}
+
+		history = { setupHash, moveCount, movesHash };
+	}
+
+	//"setoption name <id> [value <x>]", where both the id and the value may contain spaces
+	std::pair<std::string, std::string> parseSetOption(std::istringstream& iss) {
+		std::string name;
+		std::string value;
+		std::string* current = nullptr;
+
+		std::string token;
+		while (iss >> token) {
+			if (token == "name") {
+				current = &name;
+			} else if (token == "value") {
+				current = &value;
+			} else if (current) {
+				if (!current->empty()) {
+					*current += ' ';
+				}
+				*current += token;
+			}
+		}
+		return { name, value };
+	}
+
+	constexpr auto MAX_MULTI_PV = 256uz; //more than the legal moves of any position
+
+	void setEngineOption(EngineOptions& options, std::string_view name, std::string_view value) {
+		auto parseUnsigned = [value]<typename T>(T& ret) {
+			T parsed{};
+			auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+			if (ec == std::errc{}) {
+				ret = parsed;
+			}
+		};
+
+		if (name == "Threads") {
+			parseUnsigned(options.threads);
+			options.threads = std::clamp(options.threads, 1uz, AsyncSearch::getMaxThreadCount());
+		} else if (name == "Seed") {
+			parseUnsigned(options.seed);
+		} else if (name == "MultiPV") {
+			parseUnsigned(options.multiPV);
+			options.multiPV = std::clamp(options.multiPV, 1uz, MAX_MULTI_PV);
+		} else if (name == "Deterministic") {
+			options.deterministic = value == "true";
+		} else if (name == "Ponder") {
+			options.ponder = value == "true";
+		} else {
+			debugPrint(std::format("Unknown option: {}", name));
+		}
 	}
 
 	void playUCI(SafeUnsigned<std::uint8_t> depth) {
-		SearchThread searchThread;
+		OutputWriter output;
+		SearchThread searchThread{ output }; //destroyed first, so the last bestmove is still written
 
 		std::istringstream iss;
 		std::string line;
 		std::string token;
 
 		GameState lastGameState;
+		lastGameState.depth = depth;
+		PositionHistory positionHistory;
+		EngineOptions options;
 
 		while (true) {
 			if (!std::getline(std::cin, line)) {
@@ -63,25 +147,34 @@ namespace chess {
 			if (token == "quit") {
 				break;
 			} else if (token == "position") {
-				lastGameState = makeGameState(getTokensAfterPosition(iss), depth);
+				std::string_view arguments{ line };
+				nextToken(arguments); //"position"
+				updateGameState(lastGameState, positionHistory, arguments);
 				searchThread.setPosition(lastGameState);
 			} else if (token == "ucinewgame") {
-				searchThread.stop();
+				searchThread.newGame();
 			} else if (token == "isready") {
-				debugPrint("readyok");
-				std::printf("readyok\n");
-				std::fflush(stdout);
+				output.write("readyok");
 			} else if (token == "uci") {
-				constexpr auto ENGINE_INFO = "id name Agent Smith\n"
-											 "id author Walter Stein-Smith\n"
-											 "uciok\n";
-				debugPrint(ENGINE_INFO);
-				std::printf(ENGINE_INFO);
-				std::fflush(stdout);
+				auto engineInfo = std::format("id name Agent Smith\n"
+											  "id author Walter Stein-Smith\n"
+											  "option name Threads type spin default {0} min 1 max {0}\n"
+											  "option name Seed type spin default 0 min 0 max 2147483647\n"
+											  "option name MultiPV type spin default 1 min 1 max {1}\n"
+											  "option name Deterministic type check default false\n"
+											  "option name Ponder type check default false\n"
+											  "uciok", AsyncSearch::getMaxThreadCount(), MAX_MULTI_PV);
+				output.write(std::move(engineInfo));
+			} else if (token == "setoption") {
+				auto [name, value] = parseSetOption(iss);
+				setEngineOption(options, name, value);
+				searchThread.setOptions(options);
 			} else if (token == "go") {
-				searchThread.go(depth); 
+				searchThread.go(parseGoCommand(getRemainingTokens(iss)));
 			} else if (token == "stop") {
 				searchThread.stop();
+			} else if (token == "ponderhit") {
+				searchThread.ponderHit();
 			}
 		}
 	}
@@ -1,12 +1,15 @@
 import std;
 
 import Chess.Arena;
+import Chess.Benchmark;
+import Chess.EnvironmentVariable;
 import Chess.BitboardImage;
 import Chess.MoveGeneration;
 import Chess.UCI;
 import Chess.MeasureMoveTime;
 import Chess.Move;
 import Chess.SafeInt;
+import Chess.SearchTrace;
 import Chess.Tests;
 
 namespace chess {
@@ -73,15 +76,54 @@ namespace chess {
 		playUCI(depth);
 	}
 
+	void handleSearchStatistics(const char** argv, int argc) {
+		constexpr auto DEFAULT_DEPTH = 7;
+		int depth = DEFAULT_DEPTH;
+		if (argc > 2) {
+			auto depthStr = argv[2];
+			auto depthStrEnd = depthStr + std::strlen(depthStr);
+			auto depthRes = std::from_chars(depthStr, depthStrEnd, depth, 10);
+			if (depthRes.ec != std::errc{} || depth < 1 || depth > 255) {
+				std::println("Error: could not parse depth argument");
+				return;
+			}
+		}
+		std::filesystem::path sessionPath = argc > 3 ? argv[3] : getAssetDirectoryPath() / "profiling_sessions" / "search_statistics.json";
+		runSearchStatistics(SafeUnsigned{ static_cast<std::uint8_t>(depth) }, sessionPath);
+	}
+
+	void handleTraceJson(const char** argv, int argc) {
+		constexpr auto DEFAULT_MAX_PLY = 4;
+		std::filesystem::path tracePath = argc > 2 ? argv[2] : getSearchTracePath(0);
+		std::filesystem::path outputPath = argc > 3 ? argv[3] : "search_trace.json";
+
+		int maxPly = DEFAULT_MAX_PLY;
+		if (argc > 4) {
+			auto maxPlyStr = argv[4];
+			auto maxPlyStrEnd = maxPlyStr + std::strlen(maxPlyStr);
+			auto maxPlyRes = std::from_chars(maxPlyStr, maxPlyStrEnd, maxPly, 10);
+			if (maxPlyRes.ec != std::errc{}) {
+				std::println("Error: could not parse max ply argument");
+				return;
+			}
+		}
+
+		writeSearchTraceJson(tracePath, outputPath, maxPly);
+	}
+
 	void printCommandLineArgumentOptions() {
 		std::println("Options:");
 		std::println("(none)\t\t\t\t\t\t- Start the engine in UCI mode (default depth = 6)");
 		std::println("uci [depth]\t\t\t\t\t- Start the engine in UCI mode with specified depth");
 		std::println("test\t\t\t\t\t\t- Run all tests");
 		std::println("draw_bitboard [bitboard, base, filename]\t- Draw a bitboard image");
-		std::println("generate_bmi_table");
 		std::println("see_move_priorities [fen]");
 		std::println("measure_move_time");
+		std::println("search_stats [depth, session file]\t\t- Print search statistics and add them to a profiling session");
+		std::println("trace_stats [file]\t\t\t\t- Print per ply statistics of a search trace (built with CHESS_SEARCH_TRACE)");
+		std::println("trace_json [file, output, max ply]\t\t- Convert a search trace to a profiler visualizer JSON");
+		std::println("bench [name]\t\t\t\t\t- Run all benchmarks, or only the named one:");
+		printBenchmarkNames();
 	}
 }
 
@@ -99,10 +141,16 @@ int main(int argc, const char** argv) {
 		chess::handleBitboardInput(argv, argc);
 	} else if (std::strcmp(argv[1], "help") == 0) {
 		chess::printCommandLineArgumentOptions();
-	} else if (std::strcmp(argv[1], "generate_bmi_table") == 0) {
-		chess::storeBMITable();
 	} else if (std::strcmp(argv[1], "measure_move_time") == 0) {
 		chess::measureMoveTime();
+	} else if (std::strcmp(argv[1], "search_stats") == 0) {
+		chess::handleSearchStatistics(argv, argc);
+	} else if (std::strcmp(argv[1], "trace_stats") == 0) {
+		chess::printSearchTraceStats(argc > 2 ? std::filesystem::path{ argv[2] } : chess::getSearchTracePath(0));
+	} else if (std::strcmp(argv[1], "trace_json") == 0) {
+		chess::handleTraceJson(argv, argc);
+	} else if (std::strcmp(argv[1], "bench") == 0) {
+		chess::runBenchmark(argc > 2 ? argv[2] : "");
 	} else {
 		std::print("Invalid command line arguments. ");
 		chess::printCommandLineArgumentOptions();